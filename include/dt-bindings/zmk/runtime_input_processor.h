@@ -23,4 +23,54 @@
 /** Snap to Y axis (vertical only) */
 #define AXIS_SNAP_MODE_Y 2
 
+/**
+ * @brief Attribute IDs of the emulated sensor (zmk,runtime-input-processor-sensor-emul)
+ *
+ * Private sensor attributes start at SENSOR_ATTR_PRIV_START (0x8000).
+ */
+
+/** CPI, val1 = counts per inch */
+#define RIP_SENSOR_EMUL_ATTR_CPI 0x8000
+
+/** Swap X and Y, val1 = 0/1 */
+#define RIP_SENSOR_EMUL_ATTR_SWAP_XY 0x8001
+
+/** Invert reported X axis, val1 = 0/1 */
+#define RIP_SENSOR_EMUL_ATTR_INVERT_X 0x8002
+
+/** Invert reported Y axis, val1 = 0/1 */
+#define RIP_SENSOR_EMUL_ATTR_INVERT_Y 0x8003
+
+/**
+ * @brief First parameter of the input injection behavior (zmk,behavior-input-processor-inject)
+ *
+ * The second parameter is the event value.
+ */
+#define RIP_INJECT(type, code, sync) (((type) << 24) | ((code) << 8) | ((sync) & 1))
+
+/**
+ * @brief Directions of the key scroll behavior (zmk,behavior-input-processor-key-scroll)
+ */
+#define RIP_KEY_SCROLL_UP 0
+#define RIP_KEY_SCROLL_DOWN 1
+#define RIP_KEY_SCROLL_LEFT 2
+#define RIP_KEY_SCROLL_RIGHT 3
+
+/**
+ * @brief Parameters of the parameterized temp-config behavior
+ * (zmk,behavior-input-processor-temp-config-param)
+ *
+ * param1 is RIP_SCALE(multiplier, divisor), 16 bits each (0 = no change).
+ * param2 is the rotation in degrees, or RIP_ROTATION_KEEP for no change.
+ */
+#define RIP_SCALE(mul, div) ((((mul) & 0xFFFF) << 16) | ((div) & 0xFFFF))
+#define RIP_SCALE_KEEP RIP_SCALE(0, 0)
+#define RIP_ROTATION_KEEP 0x7FFF
+
+/**
+ * @brief Parameter of the benchmark probe (zmk,input-processor-bench-probe)
+ */
+#define RIP_BENCH_START 0
+#define RIP_BENCH_END 1
+
 #endif /* ZMK_DT_BINDINGS_INPUT_PROCESSOR_H_ */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Wear-leveled record ring
+ *
+ * Small values that change often (usage counters, learned thresholds, last
+ * used temporary settings) are appended to a dedicated flash partition
+ * instead of being rewritten through the settings subsystem. Every write
+ * takes the next fixed-size slot and a sector is only erased when the ring
+ * wraps around to it, so erases are spread evenly over the partition. The
+ * latest record of each key is recovered at boot in a single pass.
+ *
+ * The partition is selected with the `zmk,runtime-input-processor-storage`
+ * chosen node.
+ */
+
+/**
+ * Record key of the n-th telemetry record. There is one per runtime input
+ * processor; records carry a CRC of their processor's name and are matched to
+ * the processors by name at boot, not by processor ID.
+ */
+#define ZMK_INPUT_PROCESSOR_RECORD_KEY_TELEMETRY(n) (n)
+
+/**
+ * @brief Record ring write counters
+ */
+struct zmk_input_processor_record_ring_stats {
+    uint32_t lifetime_writes; // Records written since the partition was formatted
+    uint32_t writes;          // Records written since boot
+    uint32_t skipped_writes;  // Writes since boot skipped because the value was unchanged
+    uint32_t relocations;     // Records copied forward since boot to free a sector
+    uint32_t erases;          // Sector erases since boot
+    uint16_t sector_count;
+    uint16_t slots_per_sector;
+    uint16_t live_records; // Keys with a valid record
+};
+
+/**
+ * @brief Append a record
+ *
+ * Nothing is written when the value equals the latest record of the key.
+ *
+ * @param key Record key, below CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING_MAX_KEYS
+ * @param data Record payload
+ * @param len Payload length, at most CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING_MAX_LEN
+ * @return 0 on success, -ENOTSUP if the record ring is disabled, negative error code on failure
+ */
+int zmk_input_processor_record_ring_write(uint8_t key, const void *data, size_t len);
+
+/**
+ * @brief Read the latest record of a key
+ *
+ * @param key Record key
+ * @param data Buffer for the payload
+ * @param len Buffer size
+ * @return Payload length on success, -ENOENT if the key has no record, -ENOTSUP if the record
+ *         ring is disabled, negative error code on failure
+ */
+int zmk_input_processor_record_ring_read(uint8_t key, void *data, size_t len);
+
+/**
+ * @brief Get record ring write counters
+ *
+ * @param stats Pointer to store the counters
+ * @return 0 on success, -ENOTSUP if the record ring is disabled, negative error code on failure
+ */
+int zmk_input_processor_record_ring_get_stats(struct zmk_input_processor_record_ring_stats *stats);
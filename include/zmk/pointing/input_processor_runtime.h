@@ -7,7 +7,9 @@
 #pragma once
 
 #include <zephyr/device.h>
+#include <zephyr/sys/util.h>
 #include <stdbool.h>
+#include <zmk/pointing/input_processor_runtime_fields.h>
 
 /**
  * @brief Axis snap mode
@@ -22,36 +24,142 @@ enum zmk_input_processor_axis_snap_mode {
  * @brief Runtime input processor configuration
  */
 struct zmk_input_processor_runtime_config {
+    // See input_processor_runtime_fields.h for the fields
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(ZMK_INPUT_PROCESSOR_RUNTIME_FIELD_DECLARE)
+};
+
+/**
+ * @brief Sensor health telemetry derived from the motion stream
+ */
+struct zmk_input_processor_runtime_telemetry {
+    uint64_t distance;             // Cumulative distance travelled (input counts)
+    uint32_t frames;               // Frames observed
+    uint32_t spikes;               // Frames far above the recent motion level
+    uint32_t jitter_frames;        // Tiny motions reversing direction at rest
+    uint32_t jitter_max_amplitude; // Largest jitter frame (input counts)
+    uint32_t zero_runs;            // Runs of frames without motion (lift / lost tracking)
+    uint32_t max_zero_run;         // Longest run of frames without motion
+};
+
+/**
+ * @brief Latency governor state
+ */
+struct zmk_input_processor_runtime_governor {
+    uint32_t budget_us;                // Handler time budget per event
+    uint32_t average_us;               // Recent handler time (moving average)
+    uint32_t peak_us;                  // Longest handler time since boot
+    uint32_t degradations;             // Times the optional stages were turned off
+    uint32_t degraded_events;          // Events handled with the optional stages off
+    uint32_t skipped_telemetry_frames; // Frames telemetry did not count while degraded
+    bool degraded;                     // Optional stages are currently off
+};
+
+/**
+ * @brief Layout version of struct zmk_input_processor_runtime_diagnostics
+ */
+#define ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_VERSION 3
+
+/**
+ * @brief State flags in a diagnostic snapshot
+ */
+enum zmk_input_processor_runtime_diag_flag {
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_HAS_X = BIT(0),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_HAS_Y = BIT(1),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_REMAINDER_RESET_X = BIT(2),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_REMAINDER_RESET_Y = BIT(3),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_TEMP_LAYER_ENABLED = BIT(4),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_TEMP_LAYER_ACTIVE = BIT(5),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_TEMP_LAYER_KEEP_ACTIVE = BIT(6),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_XY_TO_SCROLL = BIT(7),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_XY_SWAP = BIT(8),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_X_INVERT = BIT(9),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_Y_INVERT = BIT(10),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_SENSOR_OFFLOAD = BIT(11),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_GESTURE_TRACKING = BIT(12),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_GOVERNOR_DEGRADED = BIT(13),
+};
+
+/**
+ * @brief Pending work items in a diagnostic snapshot
+ */
+enum zmk_input_processor_runtime_diag_work {
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_SAVE = BIT(0),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_TEMP_LAYER_ACTIVATION = BIT(1),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_TEMP_LAYER_DEACTIVATION = BIT(2),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_SENSOR_OFFLOAD = BIT(3),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_TELEMETRY_SAVE = BIT(4),
+    ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_GESTURE = BIT(5),
+};
+
+/**
+ * @brief Internal state of one processor, for bug reports
+ *
+ * Packed, little-endian on all supported targets. Timestamps are the low
+ * 32 bits of k_uptime_get(), compare them with uptime_ms.
+ */
+struct zmk_input_processor_runtime_diagnostics {
+    uint8_t id;
+    uint8_t temp_layer_layer;
+    uint8_t axis_snap_mode;
+    uint8_t pending_keypresses; // Key presses queued for temp-layer evaluation
+    uint16_t flags;             // zmk_input_processor_runtime_diag_flag
+    uint16_t pending_work;      // zmk_input_processor_runtime_diag_work
     uint32_t scale_multiplier;
     uint32_t scale_divisor;
     int32_t rotation_degrees;
-    // Temp-layer layer settings
-    bool temp_layer_enabled;
-    uint8_t temp_layer_layer;
-    uint16_t temp_layer_activation_delay_ms;
-    uint16_t temp_layer_deactivation_delay_ms;
-    // Active layers bitmask (0 = all layers, otherwise each bit represents a layer)
     uint32_t active_layers;
-    // Axis snap settings
-    uint8_t axis_snap_mode;        // zmk_input_processor_axis_snap_mode
-    uint16_t axis_snap_threshold;  // Threshold for unsnapping
-    uint16_t axis_snap_timeout_ms; // Time window for checking threshold
-    // Code mapping settings
-    bool xy_to_scroll_enabled; // Map X/Y to horizontal/vertical scroll
-    bool xy_swap_enabled;      // Swap X and Y axes
-    // Axis reverse settings
-    bool x_invert; // Whether to invert X axis
-    bool y_invert; // Whether to invert Y axis
+    int32_t last_x; // Pending half of a rotation pair
+    int32_t last_y;
+    int32_t axis_snap_cross_axis_accum;
+    uint16_t history_count;
+    uint32_t uptime_ms;
+    uint32_t last_input_ms;
+    uint32_t last_keypress_ms;
+    uint32_t axis_snap_last_decay_ms;
+    int32_t gyro_bias_q8[2];
+    uint32_t dropped_keypresses; // Key presses dropped on a full queue since boot
+} __packed;
+
+/**
+ * @brief Code paths covered by the stack report
+ */
+enum zmk_input_processor_runtime_stack_path {
+    ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_INPUT = 0, // Input event handler
+    ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_RPC,       // Studio RPC request handler
+    ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_NOTIFY,    // Studio notification listener
+    ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_WORK,      // Work items (temp-layer, save, key presses)
+    ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_COUNT,
+};
+
+/**
+ * @brief Stack high-water mark of a thread that ran one of the code paths
+ */
+struct zmk_input_processor_runtime_stack_usage {
+    enum zmk_input_processor_runtime_stack_path path;
+    const char *thread_name; // "?" without CONFIG_THREAD_NAME
+    size_t size;             // Stack size in bytes
+    size_t used;             // Worst-case bytes used since boot
+};
+
+/**
+ * @brief Scroll mode applied temporarily by the drag-scroll behavior
+ */
+struct zmk_input_processor_runtime_scroll_mode {
+    uint32_t scale_multiplier;
+    uint32_t scale_divisor;
+    uint8_t axis_snap_mode; // zmk_input_processor_axis_snap_mode
+    uint16_t axis_snap_threshold;
+    uint16_t axis_snap_timeout_ms;
 };
 
 /**
  * @brief Set the scaling parameters for a runtime input processor
  *
  * @param dev Pointer to the device structure
- * @param multiplier Scaling multiplier (must be > 0)
- * @param divisor Scaling divisor (must be > 0)
+ * @param multiplier Scaling multiplier (0 keeps the current one)
+ * @param divisor Scaling divisor (0 keeps the current one)
  * @param persistent If true, save to persistent storage; if false, temporary
- * @return 0 on success, negative error code on failure
+ * @return 0 on success, -EINVAL if the reduced ratio does not fit in 31-bit terms
  */
 int zmk_input_processor_runtime_set_scaling(const struct device *dev, uint32_t multiplier,
                                             uint32_t divisor, bool persistent);
@@ -82,6 +190,21 @@ int zmk_input_processor_runtime_reset(const struct device *dev);
  */
 void zmk_input_processor_runtime_restore_persistent(const struct device *dev);
 
+/**
+ * @brief Temporarily switch a processor into scroll mode
+ *
+ * Enables XY-to-scroll and applies the scroll scale and axis snap in one step,
+ * so no event is processed with a partially applied mode. Snap accumulator,
+ * rotation pairing and scaling remainders are reset. Leave scroll mode with
+ * zmk_input_processor_runtime_restore_persistent().
+ *
+ * @param dev Pointer to the device structure
+ * @param mode Scroll mode configuration (scale multiplier and divisor must be > 0)
+ * @return 0 on success, negative error code on failure
+ */
+int zmk_input_processor_runtime_enter_scroll_mode(
+    const struct device *dev, const struct zmk_input_processor_runtime_scroll_mode *mode);
+
 /**
  * @brief Get the current configuration of a runtime input processor
  *
@@ -300,3 +423,75 @@ int zmk_input_processor_runtime_set_x_invert(const struct device *dev, bool inve
  */
 int zmk_input_processor_runtime_set_y_invert(const struct device *dev, bool invert,
                                              bool persistent);
+
+/**
+ * @brief Get sensor health telemetry
+ *
+ * @param dev Pointer to the device structure
+ * @param telemetry Pointer to store the telemetry
+ * @return 0 on success, -ENOTSUP if telemetry is disabled, negative error code on failure
+ */
+int zmk_input_processor_runtime_get_telemetry(
+    const struct device *dev, struct zmk_input_processor_runtime_telemetry *telemetry);
+
+/**
+ * @brief Reset sensor health telemetry and save it
+ *
+ * @param dev Pointer to the device structure
+ * @return 0 on success, -ENOTSUP if telemetry is disabled, negative error code on failure
+ */
+int zmk_input_processor_runtime_reset_telemetry(const struct device *dev);
+
+/**
+ * @brief Get latency governor state
+ *
+ * @param dev Pointer to the device structure
+ * @param governor Pointer to store the state
+ * @return 0 on success, -ENOTSUP if the governor is disabled, negative error code on failure
+ */
+int zmk_input_processor_runtime_get_governor(
+    const struct device *dev, struct zmk_input_processor_runtime_governor *governor);
+
+/**
+ * @brief Capture the internal state of all runtime input processors
+ *
+ * All processors are captured in one step with the scheduler locked, so the
+ * snapshot is consistent across processors.
+ *
+ * @param records Array to store one record per processor
+ * @param max_records Capacity of the array
+ * @return Number of records stored
+ */
+size_t zmk_input_processor_runtime_capture_diagnostics(
+    struct zmk_input_processor_runtime_diagnostics *records, size_t max_records);
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STACK_REPORT)
+/**
+ * @brief Record that a code path runs on the current thread
+ *
+ * Cheap enough for every event: the stack itself is only measured when a
+ * report is requested.
+ *
+ * @param path Code path being entered
+ */
+void zmk_input_processor_runtime_stack_mark(enum zmk_input_processor_runtime_stack_path path);
+#else
+static inline void
+zmk_input_processor_runtime_stack_mark(enum zmk_input_processor_runtime_stack_path path) {}
+#endif
+
+/**
+ * @brief Measure the stack high-water marks of the threads running each code path
+ *
+ * The figures are per thread, not per code path: they cover everything that
+ * ran on the thread since boot, including code outside this module. Use them
+ * to size those threads' stacks, not to measure the module's own depth.
+ *
+ * @param callback Callback called for each (path, thread) pair seen so far
+ * @param user_data User data to pass to the callback
+ * @return 0 on success, -ENOTSUP if the stack report is disabled, or the first
+ *         non-zero value returned by callback
+ */
+int zmk_input_processor_runtime_foreach_stack_usage(
+    int (*callback)(const struct zmk_input_processor_runtime_stack_usage *usage, void *user_data),
+    void *user_data);
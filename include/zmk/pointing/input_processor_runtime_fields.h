@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @brief Runtime-tunable fields of a runtime input processor
+ *
+ * X(type, name, dt_prop, dt_default, ...) is expanded once per field, with any
+ * extra arguments passed through as the trailing arguments. It generates the
+ * public config struct, the processor's current/persistent/initial values and
+ * DT defaults, the settings record and every copy between them.
+ *
+ * The order is the layout of the saved settings record. Add new fields at the
+ * end; changing the list invalidates settings saved by older firmware.
+ */
+#define ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(X, ...)                                                 \
+    X(uint32_t, scale_multiplier, scale_multiplier, 1, __VA_ARGS__)                                \
+    X(uint32_t, scale_divisor, scale_divisor, 1, __VA_ARGS__)                                      \
+    X(int32_t, rotation_degrees, rotation_degrees, 0, __VA_ARGS__)                                 \
+    /* Temp-layer layer settings */                                                                \
+    X(bool, temp_layer_enabled, temp_layer_enabled, 0, __VA_ARGS__)                                \
+    X(uint8_t, temp_layer_layer, temp_layer, 0, __VA_ARGS__)                                       \
+    X(uint16_t, temp_layer_activation_delay_ms, temp_layer_activation_delay_ms, 100, __VA_ARGS__)  \
+    X(uint16_t, temp_layer_deactivation_delay_ms, temp_layer_deactivation_delay_ms, 500,           \
+      __VA_ARGS__)                                                                                 \
+    /* Active layers bitmask (0 = all layers, otherwise each bit represents a layer) */            \
+    X(uint32_t, active_layers, active_layers, 0, __VA_ARGS__)                                      \
+    /* Axis snap settings (zmk_input_processor_axis_snap_mode, unsnap threshold, window) */        \
+    X(uint8_t, axis_snap_mode, axis_snap_mode, 0, __VA_ARGS__)                                     \
+    X(uint16_t, axis_snap_threshold, axis_snap_threshold, 100, __VA_ARGS__)                        \
+    X(uint16_t, axis_snap_timeout_ms, axis_snap_timeout_ms, 1000, __VA_ARGS__)                     \
+    /* Code mapping settings (X/Y to horizontal/vertical scroll, swap X and Y) */                  \
+    X(bool, xy_to_scroll_enabled, xy_to_scroll_enabled, 0, __VA_ARGS__)                            \
+    X(bool, xy_swap_enabled, xy_swap_enabled, 0, __VA_ARGS__)                                      \
+    /* Axis reverse settings */                                                                    \
+    X(bool, x_invert, x_invert, 0, __VA_ARGS__)                                                    \
+    X(bool, y_invert, y_invert, 0, __VA_ARGS__)
+
+/** Declare a field: `type name;` */
+#define ZMK_INPUT_PROCESSOR_RUNTIME_FIELD_DECLARE(type, name, dt_prop, dt_default, ...) type name;
+
+/** Copy a field between structs with the same field names: `dst->name = src->name;` */
+#define ZMK_INPUT_PROCESSOR_RUNTIME_FIELD_COPY(type, name, dt_prop, dt_default, dst, src)         \
+    (dst)->name = (src)->name;
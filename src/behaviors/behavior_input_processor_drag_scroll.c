@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_input_processor_drag_scroll
+
+#include <zephyr/device.h>
+#include <drivers/behavior.h>
+#include <zephyr/logging/log.h>
+#include <zmk/pointing/input_processor_runtime.h>
+#include <zmk/behavior.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+struct behavior_input_processor_drag_scroll_config {
+    const char *processor_name;
+    struct zmk_input_processor_runtime_scroll_mode mode;
+};
+
+struct behavior_input_processor_drag_scroll_data {
+    const struct device *processor;
+    bool is_active;
+};
+
+static int behavior_input_processor_drag_scroll_init(const struct device *dev) {
+    struct behavior_input_processor_drag_scroll_data *data = dev->data;
+    const struct behavior_input_processor_drag_scroll_config *cfg = dev->config;
+
+    // Find the processor by name
+    data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    if (!data->processor) {
+        LOG_ERR("Input processor '%s' not found", cfg->processor_name);
+        return -ENODEV;
+    }
+
+    data->is_active = false;
+    LOG_DBG("Drag scroll behavior initialized for processor: %s", cfg->processor_name);
+    return 0;
+}
+
+static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
+                                     struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_drag_scroll_data *data = dev->data;
+    const struct behavior_input_processor_drag_scroll_config *cfg = dev->config;
+
+    if (!data->processor) {
+        return -ENODEV;
+    }
+
+    // Switch mapping, scale and snap together (non-persistent)
+    int ret = zmk_input_processor_runtime_enter_scroll_mode(data->processor, &cfg->mode);
+    if (ret < 0) {
+        LOG_ERR("Failed to enter scroll mode: %d", ret);
+        return ret;
+    }
+
+    data->is_active = true;
+    LOG_INF("Drag scroll started on %s", cfg->processor_name);
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
+                                      struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_drag_scroll_data *data = dev->data;
+    const struct behavior_input_processor_drag_scroll_config *cfg = dev->config;
+
+    if (!data->processor || !data->is_active) {
+        return 0;
+    }
+
+    // Restore persistent configuration
+    zmk_input_processor_runtime_restore_persistent(data->processor);
+
+    data->is_active = false;
+    LOG_INF("Drag scroll stopped on %s", cfg->processor_name);
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api behavior_input_processor_drag_scroll_driver_api = {
+    .binding_pressed = on_keymap_binding_pressed,
+    .binding_released = on_keymap_binding_released,
+};
+
+#define DRAG_SCROLL_INST(n)                                                                        \
+    BUILD_ASSERT(DT_INST_PROP(n, scale_multiplier) > 0 && DT_INST_PROP(n, scale_divisor) > 0,      \
+                 "Drag scroll scale must be non-zero");                                            \
+    static struct behavior_input_processor_drag_scroll_data                                        \
+        behavior_input_processor_drag_scroll_data_##n;                                             \
+    static const struct behavior_input_processor_drag_scroll_config                                \
+        behavior_input_processor_drag_scroll_config_##n = {                                        \
+            .processor_name = DT_INST_PROP(n, processor_name),                                     \
+            .mode =                                                                                \
+                {                                                                                  \
+                    .scale_multiplier = DT_INST_PROP(n, scale_multiplier),                         \
+                    .scale_divisor = DT_INST_PROP(n, scale_divisor),                               \
+                    .axis_snap_mode = DT_INST_PROP(n, snap_mode),                                  \
+                    .axis_snap_threshold = DT_INST_PROP(n, snap_threshold),                        \
+                    .axis_snap_timeout_ms = DT_INST_PROP(n, snap_timeout_ms),                      \
+                },                                                                                 \
+    };                                                                                             \
+    BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_drag_scroll_init, NULL,                    \
+                            &behavior_input_processor_drag_scroll_data_##n,                        \
+                            &behavior_input_processor_drag_scroll_config_##n, POST_KERNEL,         \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,                                   \
+                            &behavior_input_processor_drag_scroll_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(DRAG_SCROLL_INST)
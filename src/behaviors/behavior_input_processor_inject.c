@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_input_processor_inject
+
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <drivers/behavior.h>
+#include <zephyr/logging/log.h>
+#include <zmk/behavior.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+static int behavior_input_processor_inject_init(const struct device *dev) { return 0; }
+
+static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
+                                     struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+
+    // param1 = RIP_INJECT(type, code, sync), param2 = value
+    uint8_t type = (binding->param1 >> 24) & 0xFF;
+    uint16_t code = (binding->param1 >> 8) & 0xFFFF;
+    bool sync = binding->param1 & 1;
+    int32_t value = (int32_t)binding->param2;
+
+    LOG_DBG("Inject: type=%d code=%d value=%d sync=%d", type, code, value, sync);
+
+    int ret = input_report(dev, type, code, value, sync, K_FOREVER);
+    if (ret < 0) {
+        LOG_ERR("Failed to inject input event: %d", ret);
+        return ret;
+    }
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
+                                      struct zmk_behavior_binding_event event) {
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api behavior_input_processor_inject_driver_api = {
+    .binding_pressed = on_keymap_binding_pressed,
+    .binding_released = on_keymap_binding_released,
+};
+
+#define INJECT_INST(n)                                                                             \
+    BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_inject_init, NULL, NULL, NULL,             \
+                            POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,                      \
+                            &behavior_input_processor_inject_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(INJECT_INST)
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_input_processor_key_scroll
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/input/input.h>
+#include <drivers/behavior.h>
+#include <zephyr/logging/log.h>
+#include <zmk/behavior.h>
+#include <dt-bindings/zmk/runtime_input_processor.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+struct behavior_input_processor_key_scroll_config {
+    uint16_t tick_ms;
+    uint32_t start_speed; // counts per second
+    uint32_t max_speed;   // counts per second
+    uint16_t ramp_ms;
+};
+
+struct behavior_input_processor_key_scroll_data {
+    const struct device *dev;
+    struct k_work_delayable tick_work;
+    uint8_t pressed[4]; // Held keys per RIP_KEY_SCROLL_* direction
+    int64_t start_time;
+    int32_t remainder_q8[2]; // Sub-count carry per axis (HWHEEL, WHEEL), Q8
+    bool frame_open;         // HWHEEL reported, its synced WHEEL was dropped
+};
+
+// Current speed in counts per second, ramping linearly from start to max
+static uint32_t key_scroll_speed(const struct behavior_input_processor_key_scroll_config *cfg,
+                                 int64_t elapsed) {
+    if (cfg->ramp_ms == 0 || elapsed >= cfg->ramp_ms) {
+        return cfg->max_speed;
+    }
+    int64_t span = (int64_t)cfg->max_speed - cfg->start_speed;
+    return cfg->start_speed + (int32_t)(span * elapsed / cfg->ramp_ms);
+}
+
+// Accumulate one tick of motion in Q8 and return the whole counts to report
+static int32_t key_scroll_step(int32_t *remainder_q8, int direction, uint32_t step_q8) {
+    *remainder_q8 += direction * (int32_t)step_q8;
+    int32_t out = *remainder_q8 / 256;
+    *remainder_q8 -= out * 256;
+    return out;
+}
+
+static bool key_scroll_held(const struct behavior_input_processor_key_scroll_data *data) {
+    for (int i = 0; i < ARRAY_SIZE(data->pressed); i++) {
+        if (data->pressed[i] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// End a frame left open by a dropped WHEEL report with an empty synced one
+static void key_scroll_close_frame(struct behavior_input_processor_key_scroll_data *data) {
+    if (input_report(data->dev, INPUT_EV_REL, INPUT_REL_WHEEL, 0, true, K_NO_WAIT) == 0) {
+        data->frame_open = false;
+    }
+}
+
+static void key_scroll_tick(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct behavior_input_processor_key_scroll_data *data =
+        CONTAINER_OF(dwork, struct behavior_input_processor_key_scroll_data, tick_work);
+    const struct behavior_input_processor_key_scroll_config *cfg = data->dev->config;
+
+    if (!key_scroll_held(data)) {
+        // Released with a frame still open: tick until it is closed
+        if (data->frame_open) {
+            key_scroll_close_frame(data);
+        }
+        if (data->frame_open) {
+            k_work_schedule(&data->tick_work, K_MSEC(cfg->tick_ms));
+        }
+        return;
+    }
+
+    const uint8_t *pressed = data->pressed;
+    int h_dir = (pressed[RIP_KEY_SCROLL_RIGHT] > 0) - (pressed[RIP_KEY_SCROLL_LEFT] > 0);
+    int v_dir = (pressed[RIP_KEY_SCROLL_UP] > 0) - (pressed[RIP_KEY_SCROLL_DOWN] > 0);
+    if (h_dir == 0 && v_dir == 0) {
+        // Opposite keys held together: idle, but keep ticking until released
+        if (data->frame_open) {
+            key_scroll_close_frame(data);
+        }
+        k_work_schedule(&data->tick_work, K_MSEC(cfg->tick_ms));
+        return;
+    }
+
+    uint32_t speed = key_scroll_speed(cfg, k_uptime_get() - data->start_time);
+    uint32_t step_q8 = (uint32_t)(((uint64_t)speed << 8) * cfg->tick_ms / 1000);
+
+    int32_t h = key_scroll_step(&data->remainder_q8[0], h_dir, step_q8);
+    int32_t v = key_scroll_step(&data->remainder_q8[1], v_dir, step_q8);
+
+    // Report through the listener so the scroll processor scales, snaps and
+    // tracks remainders exactly as it does for sensor scrolling. This runs on
+    // the system work queue, which must not block: a tick that finds the input
+    // queue full is dropped, the next one scrolls on. A diagonal tick whose
+    // WHEEL report is dropped after its HWHEEL went through leaves that frame
+    // open; the next synced report from this device closes it.
+    int ret = 0;
+    if (h != 0) {
+        ret = input_report(data->dev, INPUT_EV_REL, INPUT_REL_HWHEEL, h, v == 0, K_NO_WAIT);
+        if (ret == 0) {
+            data->frame_open = v != 0;
+        }
+    }
+    if (v != 0 && ret == 0) {
+        ret = input_report(data->dev, INPUT_EV_REL, INPUT_REL_WHEEL, v, true, K_NO_WAIT);
+        if (ret == 0) {
+            data->frame_open = false;
+        }
+    }
+    if (ret < 0) {
+        LOG_DBG("Key scroll tick dropped: %d", ret);
+    } else if (data->frame_open && h == 0 && v == 0) {
+        key_scroll_close_frame(data);
+    }
+
+    k_work_schedule(&data->tick_work, K_MSEC(cfg->tick_ms));
+}
+
+static int behavior_input_processor_key_scroll_init(const struct device *dev) {
+    struct behavior_input_processor_key_scroll_data *data = dev->data;
+
+    data->dev = dev;
+    k_work_init_delayable(&data->tick_work, key_scroll_tick);
+    return 0;
+}
+
+static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
+                                     struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_key_scroll_data *data = dev->data;
+    uint32_t direction = binding->param1;
+
+    if (direction > RIP_KEY_SCROLL_RIGHT) {
+        LOG_ERR("Invalid key scroll direction: %d", direction);
+        return -EINVAL;
+    }
+
+    bool idle = !key_scroll_held(data);
+    data->pressed[direction]++;
+
+    if (idle) {
+        // Start a new ramp, first step right away
+        data->start_time = k_uptime_get();
+        data->remainder_q8[0] = 0;
+        data->remainder_q8[1] = 0;
+        k_work_reschedule(&data->tick_work, K_NO_WAIT);
+        LOG_DBG("Key scroll started (direction %d)", direction);
+    }
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
+                                      struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_key_scroll_data *data = dev->data;
+    uint32_t direction = binding->param1;
+
+    if (direction > RIP_KEY_SCROLL_RIGHT || data->pressed[direction] == 0) {
+        return ZMK_BEHAVIOR_OPAQUE;
+    }
+    data->pressed[direction]--;
+
+    if (key_scroll_held(data)) {
+        return ZMK_BEHAVIOR_OPAQUE;
+    }
+
+    // A frame left open still needs its closing report from the tick
+    if (!data->frame_open) {
+        k_work_cancel_delayable(&data->tick_work);
+    }
+    LOG_DBG("Key scroll stopped");
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api behavior_input_processor_key_scroll_driver_api = {
+    .binding_pressed = on_keymap_binding_pressed,
+    .binding_released = on_keymap_binding_released,
+};
+
+#define KEY_SCROLL_INST(n)                                                                         \
+    BUILD_ASSERT(DT_INST_PROP(n, tick_ms) > 0, "Key scroll tick-ms must be non-zero");             \
+    BUILD_ASSERT(DT_INST_PROP(n, max_speed) >= DT_INST_PROP(n, start_speed),                       \
+                 "Key scroll max-speed must not be below start-speed");                            \
+    static struct behavior_input_processor_key_scroll_data                                         \
+        behavior_input_processor_key_scroll_data_##n;                                              \
+    static const struct behavior_input_processor_key_scroll_config                                 \
+        behavior_input_processor_key_scroll_config_##n = {                                         \
+            .tick_ms = DT_INST_PROP(n, tick_ms),                                                   \
+            .start_speed = DT_INST_PROP(n, start_speed),                                           \
+            .max_speed = DT_INST_PROP(n, max_speed),                                               \
+            .ramp_ms = DT_INST_PROP(n, ramp_ms),                                                   \
+    };                                                                                             \
+    BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_key_scroll_init, NULL,                     \
+                            &behavior_input_processor_key_scroll_data_##n,                         \
+                            &behavior_input_processor_key_scroll_config_##n, POST_KERNEL,          \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,                                   \
+                            &behavior_input_processor_key_scroll_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(KEY_SCROLL_INST)
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_input_processor_temp_config_param
+
+#include <zephyr/device.h>
+#include <drivers/behavior.h>
+#include <zephyr/logging/log.h>
+#include <zmk/pointing/input_processor_runtime.h>
+#include <zmk/behavior.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+struct behavior_input_processor_temp_config_param_config {
+    const struct device *processor;
+};
+
+// Bindings of one instance held at the same time
+#define TEMP_CONFIG_PARAM_MAX_HELD 4
+
+struct temp_config_param_held {
+    uint32_t position;
+    uint32_t param1;
+    uint32_t param2;
+};
+
+struct behavior_input_processor_temp_config_param_data {
+    // Held bindings, most recent last
+    struct temp_config_param_held held[TEMP_CONFIG_PARAM_MAX_HELD];
+    uint8_t held_len;
+};
+
+// param1 = RIP_SCALE(multiplier, divisor), RIP_SCALE_KEEP leaves the scale alone
+static bool temp_config_param_scale(uint32_t param1, uint32_t *multiplier, uint32_t *divisor) {
+    *multiplier = (param1 >> 16) & 0xFFFF;
+    *divisor = param1 & 0xFFFF;
+    return *multiplier > 0 && *divisor > 0;
+}
+
+// param2 = rotation in degrees, RIP_ROTATION_KEEP leaves the rotation alone
+static bool temp_config_param_rotation(uint32_t param2, int32_t *rotation) {
+    *rotation = (int32_t)param2;
+    return *rotation >= -360 && *rotation <= 360;
+}
+
+static int behavior_input_processor_temp_config_param_init(const struct device *dev) {
+    struct behavior_input_processor_temp_config_param_data *data = dev->data;
+
+    data->held_len = 0;
+    return 0;
+}
+
+static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
+                                     struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_temp_config_param_data *data = dev->data;
+    const struct behavior_input_processor_temp_config_param_config *cfg = dev->config;
+
+    if (!device_is_ready(cfg->processor)) {
+        return -ENODEV;
+    }
+
+    if (data->held_len == TEMP_CONFIG_PARAM_MAX_HELD) {
+        LOG_WRN("Too many temporary configs held for %s, ignoring position %d",
+                cfg->processor->name, event.position);
+        return ZMK_BEHAVIOR_OPAQUE;
+    }
+
+    uint32_t multiplier, divisor;
+    int32_t rotation;
+    bool has_scale = temp_config_param_scale(binding->param1, &multiplier, &divisor);
+    bool has_rotation = temp_config_param_rotation(binding->param2, &rotation);
+
+    // Apply temporary configuration (non-persistent)
+    int ret = 0;
+    if (has_scale) {
+        ret = zmk_input_processor_runtime_set_scaling(cfg->processor, multiplier, divisor, false);
+        if (ret < 0) {
+            LOG_ERR("Failed to set temporary scaling: %d", ret);
+            return ret;
+        }
+    }
+
+    if (has_rotation) {
+        ret = zmk_input_processor_runtime_set_rotation(cfg->processor, rotation, false);
+        if (ret < 0) {
+            LOG_ERR("Failed to set temporary rotation: %d", ret);
+            return ret;
+        }
+    }
+
+    data->held[data->held_len++] = (struct temp_config_param_held){
+        .position = event.position,
+        .param1 = binding->param1,
+        .param2 = binding->param2,
+    };
+    LOG_INF("Applied temporary config to %s: scale=%d/%d, rotation=%d", cfg->processor->name,
+            multiplier, divisor, rotation);
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
+                                      struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_temp_config_param_data *data = dev->data;
+    const struct behavior_input_processor_temp_config_param_config *cfg = dev->config;
+
+    int idx = -1;
+    for (int i = 0; i < data->held_len; i++) {
+        if (data->held[i].position == event.position) {
+            idx = i;
+            break;
+        }
+    }
+    if (idx < 0) {
+        return 0;
+    }
+
+    struct temp_config_param_held released = data->held[idx];
+    for (int i = idx; i < data->held_len - 1; i++) {
+        data->held[i] = data->held[i + 1];
+    }
+    data->held_len--;
+
+    // Hand each part the released binding set to the most recent binding
+    // still held that sets it, or back to its persistent value. Other
+    // temporary changes (e.g. an active drag-scroll) are left alone.
+    struct zmk_input_processor_runtime_config persistent;
+    zmk_input_processor_runtime_get_config(cfg->processor, NULL, &persistent);
+
+    uint32_t multiplier, divisor;
+    int32_t rotation;
+    if (temp_config_param_scale(released.param1, &multiplier, &divisor)) {
+        multiplier = persistent.scale_multiplier;
+        divisor = persistent.scale_divisor;
+        for (int i = data->held_len - 1; i >= 0; i--) {
+            if (temp_config_param_scale(data->held[i].param1, &multiplier, &divisor)) {
+                break;
+            }
+            multiplier = persistent.scale_multiplier;
+            divisor = persistent.scale_divisor;
+        }
+        zmk_input_processor_runtime_set_scaling(cfg->processor, multiplier, divisor, false);
+    }
+
+    if (temp_config_param_rotation(released.param2, &rotation)) {
+        rotation = persistent.rotation_degrees;
+        for (int i = data->held_len - 1; i >= 0; i--) {
+            if (temp_config_param_rotation(data->held[i].param2, &rotation)) {
+                break;
+            }
+            rotation = persistent.rotation_degrees;
+        }
+        zmk_input_processor_runtime_set_rotation(cfg->processor, rotation, false);
+    }
+
+    LOG_INF("Released temporary config for %s (%d still held)", cfg->processor->name,
+            data->held_len);
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api behavior_input_processor_temp_config_param_driver_api = {
+    .binding_pressed = on_keymap_binding_pressed,
+    .binding_released = on_keymap_binding_released,
+};
+
+#define TEMP_CONFIG_PARAM_INST(n)                                                                  \
+    static struct behavior_input_processor_temp_config_param_data                                  \
+        behavior_input_processor_temp_config_param_data_##n;                                       \
+    static const struct behavior_input_processor_temp_config_param_config                          \
+        behavior_input_processor_temp_config_param_config_##n = {                                  \
+            .processor = DEVICE_DT_GET(DT_INST_PHANDLE(n, processor)),                             \
+    };                                                                                             \
+    BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_temp_config_param_init, NULL,              \
+                            &behavior_input_processor_temp_config_param_data_##n,                  \
+                            &behavior_input_processor_temp_config_param_config_##n, POST_KERNEL,   \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,                                   \
+                            &behavior_input_processor_temp_config_param_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(TEMP_CONFIG_PARAM_INST)
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_runtime_input_processor_sensor_emul
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/logging/log.h>
+#include <dt-bindings/zmk/runtime_input_processor.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+struct rip_sensor_emul_config {
+    uint32_t initial_cpi;
+};
+
+struct rip_sensor_emul_data {
+    uint32_t cpi;
+    bool swap_xy;
+    bool invert_x;
+    bool invert_y;
+};
+
+static int rip_sensor_emul_attr_set(const struct device *dev, enum sensor_channel chan,
+                                    enum sensor_attribute attr, const struct sensor_value *val) {
+    struct rip_sensor_emul_data *data = dev->data;
+
+    switch ((int)attr) {
+    case RIP_SENSOR_EMUL_ATTR_CPI:
+        if (val->val1 <= 0) {
+            return -EINVAL;
+        }
+        data->cpi = val->val1;
+        LOG_DBG("Emulated sensor: cpi=%d", data->cpi);
+        return 0;
+    case RIP_SENSOR_EMUL_ATTR_SWAP_XY:
+        data->swap_xy = val->val1 != 0;
+        LOG_DBG("Emulated sensor: swap_xy=%d", data->swap_xy);
+        return 0;
+    case RIP_SENSOR_EMUL_ATTR_INVERT_X:
+        data->invert_x = val->val1 != 0;
+        LOG_DBG("Emulated sensor: invert_x=%d", data->invert_x);
+        return 0;
+    case RIP_SENSOR_EMUL_ATTR_INVERT_Y:
+        data->invert_y = val->val1 != 0;
+        LOG_DBG("Emulated sensor: invert_y=%d", data->invert_y);
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int rip_sensor_emul_attr_get(const struct device *dev, enum sensor_channel chan,
+                                    enum sensor_attribute attr, struct sensor_value *val) {
+    struct rip_sensor_emul_data *data = dev->data;
+
+    val->val2 = 0;
+    switch ((int)attr) {
+    case RIP_SENSOR_EMUL_ATTR_CPI:
+        val->val1 = data->cpi;
+        return 0;
+    case RIP_SENSOR_EMUL_ATTR_SWAP_XY:
+        val->val1 = data->swap_xy;
+        return 0;
+    case RIP_SENSOR_EMUL_ATTR_INVERT_X:
+        val->val1 = data->invert_x;
+        return 0;
+    case RIP_SENSOR_EMUL_ATTR_INVERT_Y:
+        val->val1 = data->invert_y;
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int rip_sensor_emul_sample_fetch(const struct device *dev, enum sensor_channel chan) {
+    return -ENOTSUP;
+}
+
+static int rip_sensor_emul_channel_get(const struct device *dev, enum sensor_channel chan,
+                                       struct sensor_value *val) {
+    return -ENOTSUP;
+}
+
+static const struct sensor_driver_api rip_sensor_emul_driver_api = {
+    .attr_set = rip_sensor_emul_attr_set,
+    .attr_get = rip_sensor_emul_attr_get,
+    .sample_fetch = rip_sensor_emul_sample_fetch,
+    .channel_get = rip_sensor_emul_channel_get,
+};
+
+static int rip_sensor_emul_init(const struct device *dev) {
+    const struct rip_sensor_emul_config *cfg = dev->config;
+    struct rip_sensor_emul_data *data = dev->data;
+
+    data->cpi = cfg->initial_cpi;
+    data->swap_xy = false;
+    data->invert_x = false;
+    data->invert_y = false;
+    return 0;
+}
+
+#define RIP_SENSOR_EMUL_INST(n)                                                                    \
+    static struct rip_sensor_emul_data rip_sensor_emul_data_##n;                                   \
+    static const struct rip_sensor_emul_config rip_sensor_emul_config_##n = {                      \
+        .initial_cpi = DT_INST_PROP(n, cpi),                                                       \
+    };                                                                                             \
+    DEVICE_DT_INST_DEFINE(n, rip_sensor_emul_init, NULL, &rip_sensor_emul_data_##n,                \
+                          &rip_sensor_emul_config_##n, POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY,   \
+                          &rip_sensor_emul_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(RIP_SENSOR_EMUL_INST)
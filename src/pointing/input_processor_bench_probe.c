@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_input_processor_bench_probe
+
+#include <drivers/input_processor.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <dt-bindings/zmk/runtime_input_processor.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+struct bench_probe_config {
+    const char *label;
+    uint32_t report_events;
+};
+
+struct bench_probe_data {
+    uint32_t start_cycles; // Cycle count when the current event entered the chain
+    uint32_t entered;      // Events that entered the chain
+    uint32_t left;         // Events that left the chain
+    uint64_t total_cycles;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint32_t checksum; // FNV-1a of the events that left the chain
+};
+
+// The cycle counter of the POSIX boards follows the simulated clock, which
+// stands still while code runs. Read the host's time-stamp counter there so
+// native_posix/native_sim runs report real cycles.
+static inline uint32_t bench_probe_cycles(void) {
+#if IS_ENABLED(CONFIG_ARCH_POSIX) && (defined(__x86_64__) || defined(__i386__))
+    return (uint32_t)__builtin_ia32_rdtsc();
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+static uint32_t fnv1a_u32(uint32_t hash, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void bench_probe_report(const struct device *dev) {
+    const struct bench_probe_config *cfg = dev->config;
+    struct bench_probe_data *data = dev->data;
+
+    // Split so that tests can compare the deterministic line only
+    LOG_INF("Bench: %s events=%d dropped=%d checksum=0x%08x", cfg->label, data->left,
+            data->entered - data->left, data->checksum);
+    LOG_INF("Bench: %s cycles/event avg=%d min=%d max=%d", cfg->label,
+            (uint32_t)(data->total_cycles / data->left), data->min_cycles, data->max_cycles);
+}
+
+static int bench_probe_handle_event(const struct device *dev, struct input_event *event,
+                                    uint32_t param1, uint32_t param2,
+                                    struct zmk_input_processor_state *state) {
+    const struct bench_probe_config *cfg = dev->config;
+    struct bench_probe_data *data = dev->data;
+
+    if (param1 == RIP_BENCH_START) {
+        data->entered++;
+        // Last, so the bookkeeping above is not measured
+        data->start_cycles = bench_probe_cycles();
+        return ZMK_INPUT_PROC_CONTINUE;
+    }
+
+    uint32_t cycles = bench_probe_cycles() - data->start_cycles;
+
+    data->left++;
+    data->total_cycles += cycles;
+    data->min_cycles = MIN(data->min_cycles, cycles);
+    data->max_cycles = MAX(data->max_cycles, cycles);
+
+    uint32_t hash = fnv1a_u32(data->checksum, ((uint32_t)event->type << 16) | event->code);
+    hash = fnv1a_u32(hash, (uint32_t)event->value);
+    data->checksum = fnv1a_u32(hash, event->sync);
+
+    if (cfg->report_events > 0 && data->left % cfg->report_events == 0) {
+        bench_probe_report(dev);
+    }
+
+    return ZMK_INPUT_PROC_CONTINUE;
+}
+
+static int bench_probe_init(const struct device *dev) {
+    struct bench_probe_data *data = dev->data;
+
+    data->entered = 0;
+    data->left = 0;
+    data->total_cycles = 0;
+    data->min_cycles = UINT32_MAX;
+    data->max_cycles = 0;
+    data->checksum = 2166136261u;
+    return 0;
+}
+
+static struct zmk_input_processor_driver_api bench_probe_driver_api = {
+    .handle_event = bench_probe_handle_event,
+};
+
+#define BENCH_PROBE_INST(n)                                                                        \
+    static struct bench_probe_data bench_probe_data_##n;                                           \
+    static const struct bench_probe_config bench_probe_config_##n = {                              \
+        .label = DT_INST_PROP(n, probe_label),                                                     \
+        .report_events = DT_INST_PROP(n, report_events),                                           \
+    };                                                                                             \
+    DEVICE_DT_INST_DEFINE(n, &bench_probe_init, NULL, &bench_probe_data_##n,                       \
+                          &bench_probe_config_##n, POST_KERNEL,                                    \
+                          CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_probe_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(BENCH_PROBE_INST)
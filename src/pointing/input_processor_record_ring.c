@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <zmk/pointing/input_processor_record_ring.h>
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define RING_PARTITION_ID DT_FIXED_PARTITION_ID(DT_CHOSEN(zmk_runtime_input_processor_storage))
+#define RING_MAX_KEYS CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING_MAX_KEYS
+#define RING_MAX_LEN CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING_MAX_LEN
+
+// On-flash record header. Records occupy fixed-size slots so the ring can be
+// scanned without trusting any length read back from flash.
+struct ring_header {
+    uint32_t seq; // Increases with every write, erased (all ones) in a free slot
+    uint8_t key;
+    uint8_t len;
+    uint16_t crc; // CRC16-CCITT over seq, key, len and the payload
+} __packed;
+
+#define RING_SLOT_SIZE ROUND_UP(sizeof(struct ring_header) + RING_MAX_LEN, 8)
+
+BUILD_ASSERT(RING_MAX_KEYS <= UINT8_MAX, "Record ring keys must fit in a byte");
+BUILD_ASSERT(RING_MAX_LEN <= UINT8_MAX, "Record ring payloads must fit a byte length");
+
+struct ring_slot {
+    struct ring_header header;
+    uint8_t payload[RING_SLOT_SIZE - sizeof(struct ring_header)];
+} __packed;
+
+BUILD_ASSERT(sizeof(struct ring_slot) == RING_SLOT_SIZE);
+
+struct ring_index_entry {
+    uint32_t seq; // 0 when the key has no record
+    uint32_t offset;
+};
+
+static struct {
+    const struct flash_area *fa;
+    bool mounted;
+    int mount_err;
+    uint8_t erased_val;
+    size_t sector_size;
+    uint16_t sector_count;
+    uint16_t slots_per_sector;
+
+    // Next slot to write
+    uint16_t sector;
+    uint16_t slot;
+    uint32_t seq; // Last sequence number written
+
+    struct ring_index_entry index[RING_MAX_KEYS];
+    struct zmk_input_processor_record_ring_stats stats;
+} ring;
+
+static K_MUTEX_DEFINE(ring_mutex);
+
+// Scratch slot, only used with ring_mutex held
+static struct ring_slot ring_buf;
+
+static uint32_t slot_offset(uint16_t sector, uint16_t slot) {
+    return (uint32_t)sector * ring.sector_size + (uint32_t)slot * RING_SLOT_SIZE;
+}
+
+static uint16_t record_crc(const struct ring_slot *rec) {
+    uint16_t crc = crc16_ccitt(0xFFFF, (const uint8_t *)&rec->header,
+                               offsetof(struct ring_header, crc));
+    return crc16_ccitt(crc, rec->payload, rec->header.len);
+}
+
+static bool is_erased(const void *buf, size_t len) {
+    const uint8_t *bytes = buf;
+    for (size_t i = 0; i < len; i++) {
+        if (bytes[i] != ring.erased_val) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Read a slot into ring_buf: 0 for a valid record, -ENOENT for a free slot and
+// -EBADMSG for anything else (torn write, interrupted erase)
+static int slot_read(uint32_t offset) {
+    int ret = flash_area_read(ring.fa, offset, &ring_buf, sizeof(ring_buf));
+    if (ret < 0) {
+        return ret;
+    }
+
+    struct ring_header *hdr = &ring_buf.header;
+    if (is_erased(hdr, sizeof(*hdr))) {
+        return -ENOENT;
+    }
+    if (hdr->key >= RING_MAX_KEYS || hdr->len > RING_MAX_LEN || hdr->seq == 0 ||
+        hdr->crc != record_crc(&ring_buf)) {
+        return -EBADMSG;
+    }
+    return 0;
+}
+
+static bool sector_is_erased(uint16_t sector) {
+    for (uint16_t slot = 0; slot < ring.slots_per_sector; slot++) {
+        if (slot_read(slot_offset(sector, slot)) != -ENOENT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int sector_erase(uint16_t sector) {
+    int ret = flash_area_erase(ring.fa, slot_offset(sector, 0), ring.sector_size);
+    if (ret < 0) {
+        LOG_ERR("Record ring: failed to erase sector %d: %d", sector, ret);
+        return ret;
+    }
+    ring.stats.erases++;
+    return 0;
+}
+
+// Write the record in ring_buf (key, len and payload set) to the next slot
+static int slot_append(void) {
+    if (ring.slot >= ring.slots_per_sector) {
+        return -ENOSPC;
+    }
+
+    uint32_t offset = slot_offset(ring.sector, ring.slot);
+    struct ring_header *hdr = &ring_buf.header;
+    hdr->seq = ring.seq + 1;
+    hdr->crc = record_crc(&ring_buf);
+    memset(ring_buf.payload + hdr->len, 0, sizeof(ring_buf.payload) - hdr->len);
+
+    // The slot is consumed even if the write fails, it may be partly written
+    ring.slot++;
+    int ret = flash_area_write(ring.fa, offset, &ring_buf, sizeof(ring_buf));
+    if (ret < 0) {
+        LOG_ERR("Record ring: failed to write key %d: %d", hdr->key, ret);
+        return ret;
+    }
+
+    ring.seq = hdr->seq;
+    ring.index[hdr->key] = (struct ring_index_entry){.seq = hdr->seq, .offset = offset};
+    ring.stats.writes++;
+    return 0;
+}
+
+// Copy the latest records still living in a sector to the write sector, then
+// erase it. An interrupted collection is finished at the next mount.
+static int sector_collect(uint16_t sector) {
+    for (int key = 0; key < RING_MAX_KEYS; key++) {
+        struct ring_index_entry *entry = &ring.index[key];
+        if (entry->seq == 0 || entry->offset / ring.sector_size != sector) {
+            continue;
+        }
+
+        int ret = slot_read(entry->offset);
+        if (ret < 0) {
+            LOG_WRN("Record ring: dropping unreadable key %d: %d", key, ret);
+            entry->seq = 0;
+            continue;
+        }
+        ret = slot_append();
+        if (ret < 0) {
+            return ret;
+        }
+        ring.stats.relocations++;
+    }
+
+    return sector_erase(sector);
+}
+
+// Move writing to the next sector, which is always kept erased, and collect
+// the sector after it so the invariant holds for the next wrap
+static int ring_advance(void) {
+    ring.sector = (ring.sector + 1) % ring.sector_count;
+    ring.slot = 0;
+    return sector_collect((ring.sector + 1) % ring.sector_count);
+}
+
+// Scan every slot once: the highest sequence per key is its latest record and
+// the highest sequence overall marks the write position
+static int ring_scan(void) {
+    int32_t last_sector = -1;
+    uint16_t last_slot = 0;
+
+    for (uint16_t sector = 0; sector < ring.sector_count; sector++) {
+        for (uint16_t slot = 0; slot < ring.slots_per_sector; slot++) {
+            uint32_t offset = slot_offset(sector, slot);
+            int ret = slot_read(offset);
+            if (ret == -ENOENT || ret == -EBADMSG) {
+                continue;
+            }
+            if (ret < 0) {
+                return ret;
+            }
+
+            const struct ring_header *hdr = &ring_buf.header;
+            struct ring_index_entry *entry = &ring.index[hdr->key];
+            if (hdr->seq > entry->seq) {
+                *entry = (struct ring_index_entry){.seq = hdr->seq, .offset = offset};
+            }
+            if (hdr->seq > ring.seq) {
+                ring.seq = hdr->seq;
+                last_sector = sector;
+                last_slot = slot;
+            }
+        }
+    }
+
+    if (last_sector < 0) {
+        // Blank or foreign content: format
+        for (uint16_t sector = 0; sector < ring.sector_count; sector++) {
+            if (!sector_is_erased(sector)) {
+                int ret = sector_erase(sector);
+                if (ret < 0) {
+                    return ret;
+                }
+            }
+        }
+        ring.sector = 0;
+        ring.slot = 0;
+        return 0;
+    }
+
+    // Continue after the newest record, past any torn slots
+    ring.sector = last_sector;
+    ring.slot = last_slot + 1;
+    while (ring.slot < ring.slots_per_sector &&
+           slot_read(slot_offset(ring.sector, ring.slot)) != -ENOENT) {
+        ring.slot++;
+    }
+
+    // Finish a collection interrupted by a reset
+    uint16_t spare = (ring.sector + 1) % ring.sector_count;
+    if (!sector_is_erased(spare)) {
+        LOG_WRN("Record ring: finishing interrupted collection of sector %d", spare);
+        return sector_collect(spare);
+    }
+    return 0;
+}
+
+static int ring_mount(void) {
+    if (ring.mounted) {
+        return ring.mount_err;
+    }
+    ring.mounted = true;
+
+    int ret = flash_area_open(RING_PARTITION_ID, &ring.fa);
+    if (ret < 0) {
+        LOG_ERR("Record ring: failed to open partition: %d", ret);
+        return ring.mount_err = ret;
+    }
+
+    struct flash_pages_info info;
+    ret = flash_get_page_info_by_offs(flash_area_get_device(ring.fa), ring.fa->fa_off, &info);
+    if (ret < 0) {
+        LOG_ERR("Record ring: failed to get sector size: %d", ret);
+        return ring.mount_err = ret;
+    }
+
+    ring.erased_val = flash_area_erased_val(ring.fa);
+    ring.sector_size = info.size;
+    ring.sector_count = ring.fa->fa_size / info.size;
+    ring.slots_per_sector = info.size / RING_SLOT_SIZE;
+
+    // Collecting a sector must always fit in a fresh one next to a new record
+    if (ring.sector_count < 2 || ring.slots_per_sector <= RING_MAX_KEYS ||
+        RING_SLOT_SIZE % flash_area_align(ring.fa) != 0) {
+        LOG_ERR("Record ring: unsupported partition (%d sectors of %d slots, write align %d)",
+                ring.sector_count, ring.slots_per_sector, (int)flash_area_align(ring.fa));
+        return ring.mount_err = -EINVAL;
+    }
+
+    ret = ring_scan();
+    if (ret < 0) {
+        LOG_ERR("Record ring: failed to scan: %d", ret);
+        return ring.mount_err = ret;
+    }
+
+    uint16_t live = 0;
+    for (int key = 0; key < RING_MAX_KEYS; key++) {
+        live += ring.index[key].seq != 0;
+    }
+    LOG_INF("Record ring: %d sectors of %d slots, %d live records, %u lifetime writes",
+            ring.sector_count, ring.slots_per_sector, live, ring.seq);
+    return ring.mount_err = 0;
+}
+
+int zmk_input_processor_record_ring_write(uint8_t key, const void *data, size_t len) {
+    if (key >= RING_MAX_KEYS || len > RING_MAX_LEN || (!data && len > 0)) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&ring_mutex, K_FOREVER);
+
+    int ret = ring_mount();
+    if (ret < 0) {
+        goto out;
+    }
+
+    // Unchanged values cost a read, not a slot
+    const struct ring_index_entry *entry = &ring.index[key];
+    if (entry->seq != 0 && slot_read(entry->offset) == 0 && ring_buf.header.len == len &&
+        memcmp(ring_buf.payload, data, len) == 0) {
+        ring.stats.skipped_writes++;
+        goto out;
+    }
+
+    if (ring.slot >= ring.slots_per_sector) {
+        ret = ring_advance();
+        if (ret < 0) {
+            goto out;
+        }
+    }
+
+    ring_buf.header.key = key;
+    ring_buf.header.len = len;
+    memcpy(ring_buf.payload, data, len);
+    ret = slot_append();
+    if (ret == 0) {
+        LOG_DBG("Record ring: wrote key %d (%d bytes) to sector %d, seq %u", key, (int)len,
+                ring.sector, ring.seq);
+    }
+
+out:
+    k_mutex_unlock(&ring_mutex);
+    return ret;
+}
+
+int zmk_input_processor_record_ring_read(uint8_t key, void *data, size_t len) {
+    if (key >= RING_MAX_KEYS || (!data && len > 0)) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&ring_mutex, K_FOREVER);
+
+    int ret = ring_mount();
+    if (ret == 0) {
+        const struct ring_index_entry *entry = &ring.index[key];
+        ret = entry->seq == 0 ? -ENOENT : slot_read(entry->offset);
+    }
+    if (ret == 0) {
+        ret = MIN(len, ring_buf.header.len);
+        memcpy(data, ring_buf.payload, ret);
+    }
+
+    k_mutex_unlock(&ring_mutex);
+    return ret;
+}
+
+int zmk_input_processor_record_ring_get_stats(struct zmk_input_processor_record_ring_stats *stats) {
+    if (!stats) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&ring_mutex, K_FOREVER);
+
+    int ret = ring_mount();
+    if (ret == 0) {
+        *stats = ring.stats;
+        stats->lifetime_writes = ring.seq;
+        stats->sector_count = ring.sector_count;
+        stats->slots_per_sector = ring.slots_per_sector;
+        stats->live_records = 0;
+        for (int key = 0; key < RING_MAX_KEYS; key++) {
+            stats->live_records += ring.index[key].seq != 0;
+        }
+    }
+
+    k_mutex_unlock(&ring_mutex);
+    return ret;
+}
+
+#else
+
+int zmk_input_processor_record_ring_write(uint8_t key, const void *data, size_t len) {
+    return -ENOTSUP;
+}
+
+int zmk_input_processor_record_ring_read(uint8_t key, void *data, size_t len) { return -ENOTSUP; }
+
+int zmk_input_processor_record_ring_get_stats(struct zmk_input_processor_record_ring_stats *stats) {
+    return -ENOTSUP;
+}
+
+#endif
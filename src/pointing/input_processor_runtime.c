@@ -13,11 +13,16 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/dlist.h>
+#include <zephyr/sys/math_extras.h>
 
 #if IS_ENABLED(CONFIG_SETTINGS)
 #include <zephyr/settings/settings.h>
 #endif
 
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+#include <zephyr/drivers/sensor.h>
+#endif
+
 #include <zmk/behavior.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/input_processor_state_changed.h>
@@ -26,9 +31,74 @@
 #include <zmk/hid.h>
 #include <zmk/keymap.h>
 #include <zmk/keys.h>
+#include <zmk/virtual_key_position.h>
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+#include <zephyr/sys/crc.h>
+#include <zmk/pointing/input_processor_record_ring.h>
+#endif
 
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
+// Telemetry is saved to the record ring when there is one, otherwise to settings
+#define TELEMETRY_SAVE                                                                             \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY) &&                                   \
+     (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING) || IS_ENABLED(CONFIG_SETTINGS)))
+
+// Motion values are 32-bit end to end. Arithmetic that can leave that range
+// (products, sums of large frames, long idle gaps) is done in 64-bit and
+// saturated instead of wrapping.
+static inline int32_t clamp_i32(int64_t value) {
+    return (int32_t)CLAMP(value, INT32_MIN, INT32_MAX);
+}
+
+static inline int16_t clamp_i16(int64_t value) {
+    return (int16_t)CLAMP(value, INT16_MIN, INT16_MAX);
+}
+
+static inline int32_t neg_sat_i32(int32_t value) { return value == INT32_MIN ? INT32_MAX : -value; }
+
+static inline int32_t abs_sat_i32(int32_t value) { return value < 0 ? neg_sat_i32(value) : value; }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY)
+#define MOTION_HISTORY_SIZE CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY_SIZE
+BUILD_ASSERT((MOTION_HISTORY_SIZE & (MOTION_HISTORY_SIZE - 1)) == 0,
+             "CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY_SIZE must be a power of two");
+
+// One processed frame: motion after orientation, before snapping and scaling
+struct motion_frame {
+    int32_t dx;
+    int32_t dy;
+    uint32_t timestamp; // k_uptime_get_32() at the frame's sync
+};
+
+// Fixed-capacity ring of the most recent frames, shared by temporal stages
+struct motion_history {
+    struct motion_frame frames[MOTION_HISTORY_SIZE];
+    uint16_t head;  // Slot of the next frame
+    uint16_t count; // Committed frames, saturates at MOTION_HISTORY_SIZE
+    // Frame being assembled until the next sync, saturated to 32 bits
+    int32_t pending_dx;
+    int32_t pending_dy;
+};
+#endif
+
+// Per-field expansions of ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS
+#define RUNTIME_FIELD_INITIAL(type, name, dt_prop, dt_default, ...) type initial_##name;
+#define RUNTIME_FIELD_VALUES(type, name, dt_prop, dt_default, ...)                                 \
+    type name;                                                                                     \
+    type persistent_##name;
+#define RUNTIME_FIELD_DT(type, name, dt_prop, dt_default, n)                                       \
+    .initial_##name = DT_INST_PROP_OR(n, dt_prop, dt_default),
+#define RUNTIME_FIELD_RESET(type, name, dt_prop, dt_default, data, cfg)                            \
+    (data)->name = (data)->persistent_##name = (cfg)->initial_##name;
+#define RUNTIME_FIELD_RESTORE(type, name, dt_prop, dt_default, data)                               \
+    (data)->name = (data)->persistent_##name;
+#define RUNTIME_FIELD_PERSISTENT(type, name, dt_prop, dt_default, dst, data)                       \
+    (dst)->name = (data)->persistent_##name;
+#define RUNTIME_FIELD_LOAD(type, name, dt_prop, dt_default, data, settings)                        \
+    (data)->name = (data)->persistent_##name = (settings)->name;
+
 struct runtime_processor_config {
     const char *name;
     uint8_t type;
@@ -36,31 +106,58 @@ struct runtime_processor_config {
     size_t y_codes_len;
     const uint16_t *x_codes;
     const uint16_t *y_codes;
-    uint32_t initial_scale_multiplier;
-    uint32_t initial_scale_divisor;
-    int32_t initial_rotation_degrees;
+    // Tunable defaults from DT
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_INITIAL)
     // Temp-layer behavior references for efficient comparison
     const struct device *temp_layer_transparent_behavior;
     const struct device *temp_layer_kp_behavior;
     size_t temp_layer_keep_keycodes_len;
     const uint16_t *temp_layer_keep_keycodes;
-    // Temp-layer default settings from DT
-    bool initial_temp_layer_enabled;
-    uint8_t initial_temp_layer_layer;
-    uint16_t initial_temp_layer_activation_delay_ms;
-    uint16_t initial_temp_layer_deactivation_delay_ms;
-    // Active layers bitmask from DT
-    uint32_t initial_active_layers;
-    // Axis snap default settings from DT
-    uint8_t initial_axis_snap_mode;
-    uint16_t initial_axis_snap_threshold;
-    uint16_t initial_axis_snap_timeout_ms;
-    // Code mapping default settings from DT
-    bool initial_xy_to_scroll_enabled;
-    bool initial_xy_swap_enabled;
-    // Axis reverse default settings from DT
-    bool initial_x_invert;
-    bool initial_y_invert;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    // Sensor offload settings from DT (attr < 0 = not supported by sensor)
+    const struct device *sensor_dev;
+    uint32_t sensor_cpi;
+    uint32_t sensor_cpi_min;
+    uint32_t sensor_cpi_max;
+    uint32_t sensor_cpi_step;
+    int32_t sensor_cpi_attr;
+    int32_t sensor_swap_xy_attr;
+    int32_t sensor_invert_x_attr;
+    int32_t sensor_invert_y_attr;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH)
+    // Convert multi-touch ABS slots into pointer motion / scroll
+    bool multi_touch;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GYRO)
+    // Angular rate input (gyro_codes[0] -> pointer X, gyro_codes[1] -> pointer Y)
+    bool gyro;
+    uint16_t gyro_type;
+    uint16_t gyro_codes[2];
+    uint16_t gyro_deadzone;
+    uint16_t gyro_rest_threshold;
+    uint8_t gyro_bias_shift;
+    uint8_t gyro_smoothing_shift;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE)
+    // Flick gesture bindings (up, down, left, right) and recognition thresholds
+    const struct zmk_behavior_binding *gesture_bindings;
+    size_t gesture_bindings_len;
+    uint32_t gesture_layers;
+    uint16_t gesture_min_distance;
+    uint32_t gesture_min_velocity;
+    uint16_t gesture_decision_ms;
+    uint16_t gesture_max_duration_ms;
+    uint16_t gesture_idle_timeout_ms;
+#endif
+};
+
+// Scale factor reduced to lowest terms, with the divisor as a shift when it is
+// a power of two
+struct scale_plan {
+    int32_t mul;
+    int32_t div;
+    int8_t shift; // log2(div) for power-of-two divisors, -1 otherwise
 };
 
 struct runtime_processor_data {
@@ -68,71 +165,33 @@ struct runtime_processor_data {
 #if IS_ENABLED(CONFIG_SETTINGS)
     struct k_work_delayable save_work;
 #endif
-    // Current active values (may be temporary from behavior)
-    uint32_t scale_multiplier;
-    uint32_t scale_divisor;
-    int32_t rotation_degrees;
-
-    // Persistent values (saved to settings, not affected by behavior)
-    uint32_t persistent_scale_multiplier;
-    uint32_t persistent_scale_divisor;
-    int32_t persistent_rotation_degrees;
+    // Tunables: current active value (may be temporary from behavior) and
+    // persistent value (saved to settings, not affected by behavior)
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_VALUES)
 
     // Precomputed rotation values
-    int32_t cos_val; // cos * 1000
-    int32_t sin_val; // sin * 1000
+    int32_t cos_val;      // cos * 1000
+    int32_t sin_val;      // sin * 1000
+    int8_t quarter_turns; // Rotation in quarter turns (0-3), -1 if not a right angle
+
+    // Effective scale reduced for the event path, rebuilt whenever the scale
+    // (or, with sensor offload, the residual) changes
+    struct scale_plan scale_plan;
 
     // Last seen X/Y values for rotation
-    int16_t last_x;
-    int16_t last_y;
+    int32_t last_x;
+    int32_t last_y;
     bool has_x;
     bool has_y;
 
-    // Temp-layer layer settings
-    bool temp_layer_enabled;
-    uint8_t temp_layer_layer;
-    uint16_t temp_layer_activation_delay_ms;
-    uint16_t temp_layer_deactivation_delay_ms;
-
-    // Persistent temp-layer settings
-    bool persistent_temp_layer_enabled;
-    uint8_t persistent_temp_layer_layer;
-    uint16_t persistent_temp_layer_activation_delay_ms;
-    uint16_t persistent_temp_layer_deactivation_delay_ms;
-
-    // Active layers bitmask (0 = all layers)
-    uint32_t active_layers;
-    uint32_t persistent_active_layers;
-
-    // Axis snap settings
-    uint8_t axis_snap_mode;
-    uint16_t axis_snap_threshold;
-    uint16_t axis_snap_timeout_ms;
-
-    // Persistent axis snap settings
-    uint8_t persistent_axis_snap_mode;
-    uint16_t persistent_axis_snap_threshold;
-    uint16_t persistent_axis_snap_timeout_ms;
-
     // Axis snap runtime state
-    int16_t axis_snap_cross_axis_accum;     // Accumulated movement on cross axis
+    int32_t axis_snap_cross_axis_accum;     // Accumulated movement on cross axis
     int64_t axis_snap_last_decay_timestamp; // Last time accumulator was decayed
 
-    // Code mapping settings
-    bool xy_to_scroll_enabled;
-    bool xy_swap_enabled;
-
-    // Persistent code mapping settings
-    bool persistent_xy_to_scroll_enabled;
-    bool persistent_xy_swap_enabled;
-
-    // Axis reverse settings
-    bool x_invert;
-    bool y_invert;
-
-    // Persistent axis reverse settings
-    bool persistent_x_invert;
-    bool persistent_y_invert;
+    // Set when the mode changed; the listener's remainders are cleared on the
+    // next event of each axis
+    bool remainder_reset_x;
+    bool remainder_reset_y;
 
     // Temp-layer runtime state
     struct k_work_delayable temp_layer_activation_work;
@@ -141,14 +200,130 @@ struct runtime_processor_data {
     bool temp_layer_keep_active; // Set by behavior to prevent deactivation
     int64_t last_input_timestamp;
     int64_t last_keypress_timestamp;
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY)
+    struct motion_history history;
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    // Sensor health counters, persisted at a slow cadence
+    struct zmk_input_processor_runtime_telemetry telemetry;
+    uint32_t telemetry_level_q4;  // Recent motion level (frame magnitude EWMA)
+    uint32_t telemetry_zero_run;  // Current run of frames without motion
+#if TELEMETRY_SAVE
+    struct k_work_delayable telemetry_save_work;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+    uint8_t telemetry_ring_key; // Record key holding this processor's telemetry
+    bool telemetry_from_ring;   // Counters were loaded from the record ring
+    bool telemetry_in_settings; // Counters saved before the ring, to be moved over
+#endif
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    // Sensor offload state: the CPI and orientation the sensor has confirmed,
+    // and the residual scale that remains to be applied in software for that
+    // CPI. The lock keeps them consistent for the event path.
+    struct k_work sensor_offload_work;
+    struct k_spinlock sensor_offload_lock;
+    bool sensor_offload_active;
+    uint32_t sensor_offload_cpi;
+    bool sensor_offload_swap_xy;
+    bool sensor_offload_invert_x;
+    bool sensor_offload_invert_y;
+    uint32_t residual_scale_multiplier;
+    uint32_t residual_scale_divisor;
+    // Last values written to the sensor (to skip redundant bus transactions)
+    bool sensor_programmed;
+    uint32_t sensor_programmed_cpi;
+    bool sensor_programmed_swap_xy;
+    bool sensor_programmed_invert_x;
+    bool sensor_programmed_invert_y;
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH)
+    // Multi-touch contact tracking, indexed by slot
+    int32_t mt_x[CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH_MAX_SLOTS];
+    int32_t mt_y[CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH_MAX_SLOTS];
+    uint32_t mt_active; // Bitmask of slots with a contact
+    uint32_t mt_has_x;  // Bitmask of slots with a known X position
+    uint32_t mt_has_y;  // Bitmask of slots with a known Y position
+    uint8_t mt_slot;    // Current slot, MAX_SLOTS if out of range
+    uint8_t mt_contacts;
+    // Remainders of two-finger averaging
+    int16_t mt_scroll_remainder_x;
+    int16_t mt_scroll_remainder_y;
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GYRO)
+    // Complementary filter state per axis, Q8 fixed point
+    int32_t gyro_bias_q8[2];
+    int32_t gyro_smooth_q8[2];
+    int16_t gyro_remainder_q8[2];
+    uint16_t gyro_settled[2]; // Consecutive rest samples while the bias settles
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE)
+    // Streaming flick gesture state, shared by the input thread and the idle
+    // work item under the lock
+    struct k_work_delayable gesture_work; // Fires when motion stops
+    struct k_spinlock gesture_lock;
+    bool gesture_tracking;
+    bool gesture_rejected; // Not a flick, motion passes through
+    int32_t gesture_accum_x; // Displacement held back by the current stroke
+    int32_t gesture_accum_y;
+    // Held motion of strokes that turned out not to be flicks, added to the
+    // next event of each axis
+    int32_t gesture_carry_x;
+    int32_t gesture_carry_y;
+    uint32_t gesture_peak_velocity; // counts per second
+    int64_t gesture_start_timestamp;
+    uint8_t gesture_input_device_index;
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+    // Latency governor: handler time against the budget
+    struct zmk_input_processor_runtime_governor governor;
+    uint32_t governor_average_q4;        // Recent handler time (us, EWMA, Q4)
+    int64_t governor_degraded_timestamp; // When the optional stages were turned off
+    uint32_t governor_excluded_cycles;   // Key handling done within the current event
+#endif
 };
 
+// Optional stages (telemetry, gyro smoothing, debug tracing) are skipped while
+// the governor finds the handler over its time budget
+static inline bool governor_degraded(const struct runtime_processor_data *data) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+    return data->governor.degraded;
+#else
+    return false;
+#endif
+}
+
+// Debug tracing on the event path
+#define TRACE_DBG(data, ...)                                                                       \
+    do {                                                                                           \
+        if (!governor_degraded(data)) {                                                            \
+            LOG_DBG(__VA_ARGS__);                                                                  \
+        }                                                                                          \
+    } while (0)
+
 static void update_rotation_values(struct runtime_processor_data *data) {
-    if (data->rotation_degrees == 0) {
-        data->cos_val = 1000;
-        data->sin_val = 0;
+    int32_t degrees = data->rotation_degrees % 360;
+    if (degrees < 0) {
+        degrees += 360;
+    }
+
+    if (degrees % 90 == 0) {
+        // Right angles are applied by swapping/negating axes, keep cos/sin
+        // exact for anything reading them
+        static const int8_t cos_quarter[] = {1, 0, -1, 0};
+        data->quarter_turns = degrees / 90;
+        data->cos_val = cos_quarter[data->quarter_turns] * 1000;
+        data->sin_val = cos_quarter[(data->quarter_turns + 3) % 4] * 1000;
         return;
     }
+    data->quarter_turns = -1;
 
     // Convert degrees to radians and compute sin/cos
     double angle_rad = (double)data->rotation_degrees * 3.14159265359 / 180.0;
@@ -159,12 +334,283 @@ static void update_rotation_values(struct runtime_processor_data *data) {
             data->sin_val);
 }
 
+static uint64_t gcd_u64(uint64_t a, uint64_t b) {
+    while (b != 0) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// True when mul/div reduces to terms scale_val() takes without changing the
+// ratio
+static bool scale_fits(uint32_t mul, uint32_t div) {
+    if (mul == 0 || div == 0) {
+        return false;
+    }
+    uint32_t g = (uint32_t)gcd_u64(mul, div);
+    return mul / g <= INT32_MAX && div / g <= INT32_MAX;
+}
+
+static void update_scale_plan(struct scale_plan *plan, uint32_t mul, uint32_t div) {
+    if (mul == 0 || div == 0) {
+        mul = 1;
+        div = 1;
+    }
+    uint64_t rmul = mul;
+    uint64_t rdiv = div;
+    uint64_t g = gcd_u64(rmul, rdiv);
+    rmul /= g;
+    rdiv /= g;
+    // Setters reject such scales; keep a stored one approximately
+    while (rmul > INT32_MAX || rdiv > INT32_MAX) {
+        rmul = MAX(rmul >> 1, 1);
+        rdiv = MAX(rdiv >> 1, 1);
+    }
+
+    plan->mul = (int32_t)rmul;
+    plan->div = (int32_t)rdiv;
+    plan->shift = -1;
+    if ((plan->div & (plan->div - 1)) == 0) {
+        plan->shift = (int8_t)u32_count_trailing_zeros(plan->div);
+    }
+}
+
+// Rebuild the plan for the scale software applies: the residual while the
+// sensor runs at an offloaded CPI, the full scale otherwise. Called with the
+// offload lock held.
+static void rebuild_scale_plan(struct runtime_processor_data *data) {
+    uint32_t mul = data->scale_multiplier;
+    uint32_t div = data->scale_divisor;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    if (data->sensor_offload_active) {
+        mul = data->residual_scale_multiplier;
+        div = data->residual_scale_divisor;
+    }
+#endif
+    update_scale_plan(&data->scale_plan, mul, div);
+}
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+static int sensor_offload_set_attr(const struct device *dev, int32_t attr, int32_t value) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct sensor_value val = {.val1 = value, .val2 = 0};
+
+    int ret = sensor_attr_set(cfg->sensor_dev, SENSOR_CHAN_ALL, (enum sensor_attribute)attr, &val);
+    if (ret < 0) {
+        LOG_ERR("Failed to set sensor attribute 0x%04x to %d for %s: %d", attr, value, cfg->name,
+                ret);
+    }
+    return ret;
+}
+
+// Stages ahead of scaling (history, telemetry, gesture, axis snap) compare
+// raw counts against limits tuned for the base CPI, so the CPI is only
+// offloaded while none of them is in use.
+static bool sensor_offload_cpi_allowed(const struct device *dev) {
+    struct runtime_processor_data *data = dev->data;
+
+    if (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY) ||
+        IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)) {
+        return false;
+    }
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE)
+    const struct runtime_processor_config *cfg = dev->config;
+    if (cfg->gesture_bindings_len > 0) {
+        return false;
+    }
+#endif
+    return data->axis_snap_mode == ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE;
+}
+
+// Orientation the sensor should apply for the current config. Returns false
+// when it has to stay in software: orientation is offloaded only as a whole,
+// and only without rotation because the sensor swaps/inverts before the
+// rotation would be applied.
+static bool sensor_offload_orientation(const struct device *dev, bool *swap_xy, bool *invert_x,
+                                       bool *invert_y) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+
+    bool orientation = cfg->sensor_swap_xy_attr >= 0 && cfg->sensor_invert_x_attr >= 0 &&
+                       cfg->sensor_invert_y_attr >= 0 && data->quarter_turns == 0;
+    *swap_xy = orientation && data->xy_swap_enabled && !data->xy_to_scroll_enabled;
+    // Sensor inversion applies to reported (post-swap) axes
+    *invert_x = orientation && (*swap_xy ? data->y_invert : data->x_invert);
+    *invert_y = orientation && (*swap_xy ? data->x_invert : data->y_invert);
+    return orientation;
+}
+
+// Residual of the current scale for a sensor running at cpi. Called with the
+// offload lock held.
+static void sensor_offload_update_residual(const struct device *dev, uint32_t cpi) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+    uint64_t rmul = data->scale_multiplier;
+    uint64_t rdiv = data->scale_divisor;
+
+    if (cpi != cfg->sensor_cpi && rmul > 0 && rdiv > 0) {
+        rmul *= cfg->sensor_cpi;
+        rdiv *= cpi;
+        uint64_t g = gcd_u64(rmul, rdiv);
+        rmul /= g;
+        rdiv /= g;
+        // Only reachable while a new scale waits for the sensor; keep the
+        // ratio approximately rather than overflowing scale_val()
+        while (rmul > INT32_MAX || rdiv > INT32_MAX) {
+            rmul = MAX(rmul >> 1, 1);
+            rdiv = MAX(rdiv >> 1, 1);
+        }
+    }
+
+    data->residual_scale_multiplier = (uint32_t)rmul;
+    data->residual_scale_divisor = (uint32_t)rdiv;
+}
+
+// Publish what the sensor applies in one step, so an event never combines the
+// residual of one sensor configuration with the orientation of another
+static void sensor_offload_publish(const struct device *dev, bool active, uint32_t cpi,
+                                   bool swap_xy, bool invert_x, bool invert_y) {
+    struct runtime_processor_data *data = dev->data;
+
+    k_spinlock_key_t key = k_spin_lock(&data->sensor_offload_lock);
+    sensor_offload_update_residual(dev, cpi);
+    data->sensor_offload_cpi = cpi;
+    data->sensor_offload_swap_xy = swap_xy;
+    data->sensor_offload_invert_x = invert_x;
+    data->sensor_offload_invert_y = invert_y;
+    data->sensor_offload_active = active;
+    rebuild_scale_plan(data);
+    k_spin_unlock(&data->sensor_offload_lock, key);
+}
+
+// Program the bound sensor for the closest native CPI/orientation and compute
+// the residual that still has to be applied in software.
+static void sensor_offload_work_handler(struct k_work *work) {
+    struct runtime_processor_data *data =
+        CONTAINER_OF(work, struct runtime_processor_data, sensor_offload_work);
+    const struct device *dev = data->dev;
+    const struct runtime_processor_config *cfg = dev->config;
+
+    if (!device_is_ready(cfg->sensor_dev)) {
+        LOG_WRN("Sensor for %s is not ready, scaling stays in software", cfg->name);
+        sensor_offload_publish(dev, false, cfg->sensor_cpi, false, false, false);
+        return;
+    }
+
+    uint32_t mul = data->scale_multiplier;
+    uint32_t div = data->scale_divisor;
+    uint32_t cpi = cfg->sensor_cpi;
+
+    if (cfg->sensor_cpi_attr >= 0 && mul > 0 && div > 0 && sensor_offload_cpi_allowed(dev)) {
+        // Closest CPI step to sensor_cpi * mul / div, within the sensor range
+        uint64_t target = ((uint64_t)cfg->sensor_cpi * mul + div / 2) / div;
+        uint32_t step = cfg->sensor_cpi_step;
+        target = ((target + step / 2) / step) * step;
+        target = CLAMP(target, cfg->sensor_cpi_min, cfg->sensor_cpi_max);
+
+        uint64_t rmul = (uint64_t)cfg->sensor_cpi * mul;
+        uint64_t rdiv = target * div;
+        uint64_t g = gcd_u64(rmul, rdiv);
+
+        // Keep the software path within the range scale_val() handles exactly,
+        // otherwise leave the sensor at its base CPI.
+        if (rmul / g <= INT16_MAX && rdiv / g <= INT16_MAX) {
+            cpi = (uint32_t)target;
+        }
+    }
+
+    bool swap_xy, invert_x, invert_y;
+    bool orientation = sensor_offload_orientation(dev, &swap_xy, &invert_x, &invert_y);
+
+    bool changed = !data->sensor_programmed || !data->sensor_offload_active;
+    int ret = 0;
+
+    if (cfg->sensor_cpi_attr >= 0 && (changed || cpi != data->sensor_programmed_cpi)) {
+        ret = sensor_offload_set_attr(dev, cfg->sensor_cpi_attr, cpi);
+        data->sensor_programmed_cpi = cpi;
+        changed = true;
+    }
+    if (ret == 0 && cfg->sensor_swap_xy_attr >= 0 &&
+        (changed || swap_xy != data->sensor_programmed_swap_xy)) {
+        ret = sensor_offload_set_attr(dev, cfg->sensor_swap_xy_attr, swap_xy);
+        data->sensor_programmed_swap_xy = swap_xy;
+        changed = true;
+    }
+    if (ret == 0 && cfg->sensor_invert_x_attr >= 0 &&
+        (changed || invert_x != data->sensor_programmed_invert_x)) {
+        ret = sensor_offload_set_attr(dev, cfg->sensor_invert_x_attr, invert_x);
+        data->sensor_programmed_invert_x = invert_x;
+        changed = true;
+    }
+    if (ret == 0 && cfg->sensor_invert_y_attr >= 0 &&
+        (changed || invert_y != data->sensor_programmed_invert_y)) {
+        ret = sensor_offload_set_attr(dev, cfg->sensor_invert_y_attr, invert_y);
+        data->sensor_programmed_invert_y = invert_y;
+        changed = true;
+    }
+
+    if (ret < 0) {
+        // Sensor state is unknown, reprogram everything next time and keep
+        // the whole transform in software meanwhile.
+        data->sensor_programmed = false;
+        sensor_offload_publish(dev, false, cfg->sensor_cpi, false, false, false);
+        return;
+    }
+
+    // The sensor now runs with the new settings; only from here on does the
+    // event path scale and orient for them
+    data->sensor_programmed = true;
+    sensor_offload_publish(dev, true, cpi, swap_xy, invert_x, invert_y);
+
+    if (changed) {
+        LOG_INF("Sensor offload for %s: cpi=%d residual=%d/%d orientation=%s", cfg->name, cpi,
+                data->residual_scale_multiplier, data->residual_scale_divisor,
+                orientation ? "sensor" : "software");
+    }
+}
+#endif
+
+// Called after every change to the scale. The residual follows the new scale
+// at once for the CPI the sensor is still running at, and the event path gets
+// a plan for it.
+static void update_scale(const struct device *dev) {
+    struct runtime_processor_data *data = dev->data;
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    k_spinlock_key_t key = k_spin_lock(&data->sensor_offload_lock);
+    if (data->sensor_offload_active) {
+        sensor_offload_update_residual(dev, data->sensor_offload_cpi);
+    }
+    rebuild_scale_plan(data);
+    k_spin_unlock(&data->sensor_offload_lock, key);
+#else
+    rebuild_scale_plan(data);
+#endif
+}
+
+// Called after every change to the scale or orientation; the sensor is
+// reprogrammed from the work queue.
+static void schedule_sensor_offload(const struct device *dev) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+
+    if (cfg->sensor_dev) {
+        k_work_submit(&data->sensor_offload_work);
+    }
+#endif
+}
+
 // Temp-layer layer work handlers
 static void temp_layer_activation_work_handler(struct k_work *work) {
     struct k_work_delayable *dwork = k_work_delayable_from_work(work);
     struct runtime_processor_data *data =
         CONTAINER_OF(dwork, struct runtime_processor_data, temp_layer_activation_work);
 
+    zmk_input_processor_runtime_stack_mark(ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_WORK);
+
     if (!data->temp_layer_enabled || data->temp_layer_layer_active) {
         return;
     }
@@ -173,7 +619,8 @@ static void temp_layer_activation_work_handler(struct k_work *work) {
     int ret = zmk_keymap_layer_activate(data->temp_layer_layer);
     if (ret == 0) {
         data->temp_layer_layer_active = true;
-        LOG_INF("Temp-layer layer %d activated", data->temp_layer_layer);
+        LOG_INF("Temp-layer layer %d activated %d ms after input", data->temp_layer_layer,
+                (int32_t)(k_uptime_get() - data->last_input_timestamp));
     } else {
         LOG_ERR("Failed to activate temp-layer layer %d: %d", data->temp_layer_layer, ret);
     }
@@ -184,6 +631,8 @@ static void temp_layer_deactivation_work_handler(struct k_work *work) {
     struct runtime_processor_data *data =
         CONTAINER_OF(dwork, struct runtime_processor_data, temp_layer_deactivation_work);
 
+    zmk_input_processor_runtime_stack_mark(ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_WORK);
+
     if (!data->temp_layer_layer_active || data->temp_layer_keep_active) {
         return;
     }
@@ -192,7 +641,8 @@ static void temp_layer_deactivation_work_handler(struct k_work *work) {
     int ret = zmk_keymap_layer_deactivate(data->temp_layer_layer);
     if (ret == 0) {
         data->temp_layer_layer_active = false;
-        LOG_INF("Temp-layer layer %d deactivated", data->temp_layer_layer);
+        LOG_INF("Temp-layer layer %d deactivated %d ms after input", data->temp_layer_layer,
+                (int32_t)(k_uptime_get() - data->last_input_timestamp));
     } else {
         LOG_ERR("Failed to deactivate temp-layer layer %d: %d", data->temp_layer_layer, ret);
     }
@@ -235,36 +685,596 @@ static bool is_processor_active_for_current_layers(uint32_t active_layers_mask)
     return false;
 }
 
-static int scale_val(struct input_event *event, uint32_t mul, uint32_t div,
-                     struct zmk_input_processor_state *state) {
-    if (mul == 0 || div == 0) {
-        return ZMK_INPUT_PROC_CONTINUE;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH)
+#define MT_MAX_SLOTS CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH_MAX_SLOTS
+
+enum multi_touch_result {
+    MULTI_TOUCH_PASS,     // Not a multi-touch event, leave untouched
+    MULTI_TOUCH_CONSUMED, // Slot bookkeeping only, nothing to report
+    MULTI_TOUCH_MOTION,   // Converted into a relative event
+};
+
+// Average two-finger deltas, carrying the remainder to the next event
+static int32_t multi_touch_halve(int32_t delta, int16_t *remainder) {
+    int64_t sum = (int64_t)delta + *remainder;
+    int64_t half = sum / 2;
+    *remainder = (int16_t)(sum - half * 2);
+    return (int32_t)half;
+}
+
+// Track contacts in fixed per-slot arrays and turn position updates into
+// relative motion: one finger moves the pointer, two fingers scroll. The
+// contact count is maintained incrementally so every event is O(1).
+static enum multi_touch_result multi_touch_process(struct runtime_processor_data *data,
+                                                   struct input_event *event) {
+    uint8_t slot = data->mt_slot;
+    uint32_t bit = slot < MT_MAX_SLOTS ? BIT(slot) : 0;
+
+    switch (event->code) {
+    case INPUT_ABS_MT_SLOT:
+        data->mt_slot = (event->value >= 0 && event->value < MT_MAX_SLOTS) ? event->value
+                                                                           : MT_MAX_SLOTS;
+        return MULTI_TOUCH_CONSUMED;
+    case INPUT_ABS_MT_TRACKING_ID:
+        if (!bit) {
+            return MULTI_TOUCH_CONSUMED;
+        }
+        if (event->value < 0) {
+            if (data->mt_active & bit) {
+                data->mt_active &= ~bit;
+                data->mt_contacts--;
+            }
+        } else if (!(data->mt_active & bit)) {
+            data->mt_active |= bit;
+            data->mt_contacts++;
+        }
+        // New or lifted contact, the next position must not produce a jump
+        data->mt_has_x &= ~bit;
+        data->mt_has_y &= ~bit;
+        return MULTI_TOUCH_CONSUMED;
+    case INPUT_ABS_MT_POSITION_X:
+    case INPUT_ABS_MT_POSITION_Y:
+        break;
+    default:
+        return MULTI_TOUCH_PASS;
+    }
+
+    if (!(data->mt_active & bit)) {
+        return MULTI_TOUCH_CONSUMED;
+    }
+
+    bool is_x = event->code == INPUT_ABS_MT_POSITION_X;
+    int32_t *pos = is_x ? &data->mt_x[slot] : &data->mt_y[slot];
+    uint32_t *has = is_x ? &data->mt_has_x : &data->mt_has_y;
+    int32_t delta = (*has & bit) ? clamp_i32((int64_t)event->value - *pos) : 0;
+    *pos = event->value;
+    *has |= bit;
+
+    if (delta == 0) {
+        return MULTI_TOUCH_CONSUMED;
+    }
+
+    event->type = INPUT_EV_REL;
+    switch (data->mt_contacts) {
+    case 1:
+        event->code = is_x ? INPUT_REL_X : INPUT_REL_Y;
+        event->value = delta;
+        return MULTI_TOUCH_MOTION;
+    case 2:
+        event->code = is_x ? INPUT_REL_HWHEEL : INPUT_REL_WHEEL;
+        event->value = multi_touch_halve(delta, is_x ? &data->mt_scroll_remainder_x
+                                                     : &data->mt_scroll_remainder_y);
+        return MULTI_TOUCH_MOTION;
+    default:
+        // Three or more fingers are left for gestures
+        return MULTI_TOUCH_CONSUMED;
     }
+}
+#endif
 
-    int16_t value_mul = event->value * (int16_t)mul;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY)
+static inline size_t motion_history_count(const struct motion_history *history) {
+    return history->count;
+}
+
+// Frame by age, 0 is the newest. Age must be below motion_history_count().
+static inline const struct motion_frame *motion_history_get(const struct motion_history *history,
+                                                            size_t age) {
+    return &history->frames[(history->head - 1 - age) & (MOTION_HISTORY_SIZE - 1)];
+}
+
+// Speed of the newest frame in counts per second (0 with fewer than 2 frames)
+static uint32_t motion_history_speed(const struct motion_history *history) {
+    if (history->count < 2) {
+        return 0;
+    }
+
+    const struct motion_frame *cur = motion_history_get(history, 0);
+    const struct motion_frame *prev = motion_history_get(history, 1);
+    uint32_t dt = MAX(cur->timestamp - prev->timestamp, 1);
+    uint64_t distance = (uint64_t)abs_sat_i32(cur->dx) + abs_sat_i32(cur->dy);
+    return (uint32_t)MIN(distance * 1000 / dt, UINT32_MAX);
+}
+
+static void motion_history_record(struct motion_history *history, bool is_x, int32_t value,
+                                  bool sync) {
+    if (is_x) {
+        history->pending_dx = clamp_i32((int64_t)history->pending_dx + value);
+    } else {
+        history->pending_dy = clamp_i32((int64_t)history->pending_dy + value);
+    }
+    if (!sync) {
+        return;
+    }
+
+    struct motion_frame *frame = &history->frames[history->head];
+    frame->dx = history->pending_dx;
+    frame->dy = history->pending_dy;
+    frame->timestamp = k_uptime_get_32();
+    history->head = (history->head + 1) & (MOTION_HISTORY_SIZE - 1);
+    if (history->count < MOTION_HISTORY_SIZE) {
+        history->count++;
+    }
+    history->pending_dx = 0;
+    history->pending_dy = 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+#define TELEMETRY_SPIKE_FACTOR 8
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+// Telemetry in the record ring is tagged with a CRC of the processor name, so
+// the counters follow their processor when devicetree nodes are reordered
+struct telemetry_ring_record {
+    uint32_t name_crc;
+    struct zmk_input_processor_runtime_telemetry telemetry;
+} __packed;
+
+static uint32_t telemetry_name_crc(const struct runtime_processor_config *cfg) {
+    return crc32_ieee((const uint8_t *)cfg->name, strlen(cfg->name));
+}
+#endif
+
+#if TELEMETRY_SAVE
+static void telemetry_save_work_handler(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct runtime_processor_data *data =
+        CONTAINER_OF(dwork, struct runtime_processor_data, telemetry_save_work);
+    const struct runtime_processor_config *cfg = data->dev->config;
+    struct zmk_input_processor_runtime_telemetry telemetry;
+    char path[64];
+
+    k_sched_lock();
+    telemetry = data->telemetry;
+    k_sched_unlock();
+
+    snprintf(path, sizeof(path), "input_proc_tm/%s", cfg->name);
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+    struct telemetry_ring_record record = {
+        .name_crc = telemetry_name_crc(cfg),
+        .telemetry = telemetry,
+    };
+    int ret = zmk_input_processor_record_ring_write(data->telemetry_ring_key, &record,
+                                                    sizeof(record));
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (ret == 0 && data->telemetry_in_settings) {
+        data->telemetry_in_settings = false;
+        settings_delete(path);
+        LOG_INF("Moved telemetry for %s from settings to the record ring", cfg->name);
+    }
+#endif
+#else
+    int ret = settings_save_one(path, &telemetry, sizeof(telemetry));
+#endif
+    if (ret < 0) {
+        LOG_ERR("Failed to save telemetry for %s: %d", cfg->name, ret);
+    } else {
+        LOG_DBG("Saved telemetry for %s", cfg->name);
+    }
+}
+#endif
+
+// Update the health counters from the frame just committed to the history.
+// Constant work per frame: only the newest two frames are looked at.
+static void telemetry_update(struct runtime_processor_data *data) {
+    struct zmk_input_processor_runtime_telemetry *tm = &data->telemetry;
+    const struct motion_frame *frame = motion_history_get(&data->history, 0);
+    // Both below 2^31, so the sum fits
+    uint32_t ax = abs_sat_i32(frame->dx);
+    uint32_t ay = abs_sat_i32(frame->dy);
+    uint32_t magnitude = ax + ay;
+
+    tm->frames++;
+    // Euclidean length approximated as max + min / 2 (within 12%)
+    tm->distance += MAX(ax, ay) + MIN(ax, ay) / 2;
+
+    if (magnitude == 0) {
+        // A sensor that is lifted (or losing tracking) syncs empty frames
+        if (data->telemetry_zero_run++ == 0) {
+            tm->zero_runs++;
+            TRACE_DBG(data, "Telemetry: zero run started, runs=%d", tm->zero_runs);
+        }
+        tm->max_zero_run = MAX(tm->max_zero_run, data->telemetry_zero_run);
+    } else {
+        if (data->telemetry_zero_run > 0) {
+            TRACE_DBG(data, "Telemetry: zero run of %d frames ended, max=%d",
+                      data->telemetry_zero_run, tm->max_zero_run);
+        }
+        data->telemetry_zero_run = 0;
+
+        // Spike: a frame far above the recent motion level. Spikes are kept
+        // out of the level so a burst of them keeps being counted.
+        uint32_t level = data->telemetry_level_q4 >> 4;
+        if (magnitude >= CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_SPIKE_THRESHOLD &&
+            magnitude > level * TELEMETRY_SPIKE_FACTOR) {
+            tm->spikes++;
+            TRACE_DBG(data, "Telemetry: spike magnitude=%d level=%d spikes=%d", magnitude, level,
+                      tm->spikes);
+        } else {
+            int64_t diff = ((int64_t)magnitude << 4) - data->telemetry_level_q4;
+            data->telemetry_level_q4 =
+                (uint32_t)MIN((int64_t)data->telemetry_level_q4 + diff / 8, UINT32_MAX);
+        }
+
+        // Jitter at rest: a tiny motion reversing the previous tiny motion
+        if (magnitude <= CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_JITTER_MAX &&
+            motion_history_count(&data->history) >= 2) {
+            const struct motion_frame *prev = motion_history_get(&data->history, 1);
+            uint32_t prev_magnitude = abs_sat_i32(prev->dx) + abs_sat_i32(prev->dy);
+            if (prev_magnitude > 0 &&
+                prev_magnitude <= CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_JITTER_MAX &&
+                ((int64_t)frame->dx * prev->dx < 0 || (int64_t)frame->dy * prev->dy < 0)) {
+                tm->jitter_frames++;
+                tm->jitter_max_amplitude = MAX(tm->jitter_max_amplitude, magnitude);
+                TRACE_DBG(data, "Telemetry: jitter magnitude=%d frames=%d", magnitude,
+                          tm->jitter_frames);
+            }
+        }
+    }
+
+#if TELEMETRY_SAVE
+    // Only schedules when no save is pending: at most one write per interval
+    k_work_schedule(&data->telemetry_save_work,
+                    K_MINUTES(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_SAVE_INTERVAL_MIN));
+#endif
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GYRO)
+// First-order low-pass in Q8: state += (target - state) / 2^shift. Steps too
+// small to register snap to the target so the state never sticks off zero.
+static void gyro_lowpass_q8(int32_t *state, int32_t target, uint8_t shift) {
+    int64_t step = ((int64_t)target - *state) / (1 << shift);
+    *state = step == 0 ? target : clamp_i32(*state + step);
+}
+
+// Turn an angular rate sample into a pointer delta for the given axis.
+// The gyro's zero-rate offset is tracked by a slow low-pass filter that only
+// runs while the device is at rest; the complementary high-pass part
+// (rate - bias) is the motion, smoothed and converted with the fraction
+// carried to the next sample.
+static void gyro_process(const struct runtime_processor_config *cfg,
+                         struct runtime_processor_data *data, struct input_event *event,
+                         int axis) {
+    int32_t rate_q8 = clamp_i32((int64_t)event->value * 256);
+    int32_t motion_q8 = clamp_i32((int64_t)rate_q8 - data->gyro_bias_q8[axis]);
+    int32_t abs_motion_q8 = abs_sat_i32(motion_q8);
+    bool at_rest = abs_motion_q8 < cfg->gyro_rest_threshold * 256;
+
+    if (data->gyro_settled[axis] < (1U << cfg->gyro_bias_shift)) {
+        // No motion is reported until the device has been still for one
+        // filter time constant. The bias is seeded from the first sample and
+        // reseeded whenever the device moves, so the zero-rate offset is
+        // never reported as motion at boot.
+        if (data->gyro_settled[axis] == 0 || !at_rest) {
+            data->gyro_bias_q8[axis] = rate_q8;
+            data->gyro_settled[axis] = 1;
+        } else {
+            gyro_lowpass_q8(&data->gyro_bias_q8[axis], rate_q8, cfg->gyro_bias_shift);
+            data->gyro_settled[axis]++;
+        }
+        motion_q8 = 0;
+    } else if (at_rest) {
+        gyro_lowpass_q8(&data->gyro_bias_q8[axis], rate_q8, cfg->gyro_bias_shift);
+    }
+    if (abs_motion_q8 < cfg->gyro_deadzone * 256) {
+        motion_q8 = 0;
+    }
+
+    gyro_lowpass_q8(&data->gyro_smooth_q8[axis], motion_q8,
+                    governor_degraded(data) ? 0 : cfg->gyro_smoothing_shift);
+
+    int32_t out_q8 = clamp_i32((int64_t)data->gyro_smooth_q8[axis] + data->gyro_remainder_q8[axis]);
+    int32_t out = out_q8 / 256;
+    // Drop the fraction once settled so it cannot leak out as drift later
+    data->gyro_remainder_q8[axis] = data->gyro_smooth_q8[axis] == 0 ? 0 : out_q8 - out * 256;
+
+    TRACE_DBG(data, "Gyro: %c rate=%d bias=%d out=%d", axis == 0 ? 'x' : 'y', event->value,
+            data->gyro_bias_q8[axis] / 256, out);
+
+    event->type = cfg->type;
+    event->code = axis == 0 ? cfg->x_codes[0] : cfg->y_codes[0];
+    event->value = out;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE)
+enum gesture_direction {
+    GESTURE_UP = 0,
+    GESTURE_DOWN = 1,
+    GESTURE_LEFT = 2,
+    GESTURE_RIGHT = 3,
+};
+
+// Hand the motion held by a stroke that is not a flick back to the pointer.
+// Called with the gesture lock held.
+static void gesture_return_held(struct runtime_processor_data *data) {
+    data->gesture_carry_x = clamp_i32((int64_t)data->gesture_carry_x + data->gesture_accum_x);
+    data->gesture_carry_y = clamp_i32((int64_t)data->gesture_carry_y + data->gesture_accum_y);
+    data->gesture_accum_x = 0;
+    data->gesture_accum_y = 0;
+}
+
+static void gesture_work_handler(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct runtime_processor_data *data =
+        CONTAINER_OF(dwork, struct runtime_processor_data, gesture_work);
+    const struct device *dev = data->dev;
+    const struct runtime_processor_config *cfg = dev->config;
+
+    k_spinlock_key_t key = k_spin_lock(&data->gesture_lock);
+    if (!data->gesture_tracking) {
+        k_spin_unlock(&data->gesture_lock, key);
+        return;
+    }
+
+    int32_t abs_x = abs_sat_i32(data->gesture_accum_x);
+    int32_t abs_y = abs_sat_i32(data->gesture_accum_y);
+    bool horizontal = abs_x > abs_y;
+    int32_t distance = horizontal ? abs_x : abs_y;
+    uint32_t peak_velocity = data->gesture_peak_velocity;
+    bool flick = !data->gesture_rejected && distance >= cfg->gesture_min_distance &&
+                 peak_velocity >= cfg->gesture_min_velocity;
+
+    enum gesture_direction dir;
+    if (horizontal) {
+        dir = data->gesture_accum_x < 0 ? GESTURE_LEFT : GESTURE_RIGHT;
+    } else {
+        dir = data->gesture_accum_y < 0 ? GESTURE_UP : GESTURE_DOWN;
+    }
+
+    data->gesture_tracking = false;
+    if (flick) {
+        data->gesture_accum_x = 0;
+        data->gesture_accum_y = 0;
+    } else {
+        gesture_return_held(data);
+    }
+    k_spin_unlock(&data->gesture_lock, key);
+
+    if (!flick) {
+        LOG_DBG("Gesture: not a flick (distance=%d, peak velocity=%d), motion returned", distance,
+                peak_velocity);
+        return;
+    }
+
+    LOG_DBG("Gesture: flick %d (distance=%d, peak velocity=%d)", dir, distance, peak_velocity);
+
+    struct zmk_behavior_binding_event event = {
+        .position = ZMK_VIRTUAL_KEY_POSITION_BEHAVIOR_INPUT_PROCESSOR(
+            data->gesture_input_device_index, zmk_input_processor_runtime_get_id(dev)),
+        .timestamp = k_uptime_get(),
+#if IS_ENABLED(CONFIG_ZMK_SPLIT)
+        .source = ZMK_POSITION_STATE_CHANGE_SOURCE_LOCAL,
+#endif
+    };
+    zmk_behavior_invoke_binding(&cfg->gesture_bindings[dir], event, true);
+    zmk_behavior_invoke_binding(&cfg->gesture_bindings[dir], event, false);
+}
+
+// Add the motion returned to the pointer to an event that passes through.
+// Called with the gesture lock held.
+static void gesture_release(struct runtime_processor_data *data, struct input_event *event,
+                            bool is_x) {
+    int32_t *carry = is_x ? &data->gesture_carry_x : &data->gesture_carry_y;
+
+    if (*carry != 0) {
+        event->value = clamp_i32((int64_t)event->value + *carry);
+        *carry = 0;
+    }
+}
+
+// Accumulate displacement and peak frame speed of a flick, reading frame speed
+// from the motion history. Motion is consumed until the gesture either ends
+// (idle timeout) or is rejected: too slow once the decision window has passed,
+// or too long to be a flick. A rejected stroke releases the held motion and
+// the rest of it passes through, so normal pointing only loses the decision
+// window. Motion held by a stroke that ends without a flick, or that is cut
+// off by leaving the gesture layers, is released the same way.
+static int gesture_process(const struct device *dev, struct input_event *event, bool is_x,
+                           struct zmk_input_processor_state *state) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+    int64_t now = k_uptime_get();
+    int ret = ZMK_INPUT_PROC_CONTINUE;
+    bool cut_off = false;
+    bool reschedule = false;
+    bool rejected = false;
+    bool too_long = false;
+
+    k_spinlock_key_t key = k_spin_lock(&data->gesture_lock);
+
+    if (!is_processor_active_for_current_layers(cfg->gesture_layers)) {
+        if (data->gesture_tracking) {
+            data->gesture_tracking = false;
+            gesture_return_held(data);
+            cut_off = true;
+        }
+        goto release;
+    }
+
+    if (!data->gesture_tracking) {
+        if (event->value == 0) {
+            goto release;
+        }
+        data->gesture_tracking = true;
+        data->gesture_rejected = false;
+        data->gesture_accum_x = 0;
+        data->gesture_accum_y = 0;
+        data->gesture_peak_velocity = 0;
+        data->gesture_start_timestamp = now;
+        data->gesture_input_device_index = state ? state->input_device_index : 0;
+    }
+
+    reschedule = true;
+
+    if (data->gesture_rejected) {
+        goto release;
+    }
+
+    if (is_x) {
+        data->gesture_accum_x = clamp_i32((int64_t)data->gesture_accum_x + event->value);
+    } else {
+        data->gesture_accum_y = clamp_i32((int64_t)data->gesture_accum_y + event->value);
+    }
+
+    // The frame has already been committed to the history on sync
+    if (event->sync) {
+        data->gesture_peak_velocity =
+            MAX(data->gesture_peak_velocity, motion_history_speed(&data->history));
+    }
+
+    int64_t elapsed = now - data->gesture_start_timestamp;
+    too_long = elapsed > cfg->gesture_max_duration_ms;
+    bool too_slow = event->sync && elapsed >= cfg->gesture_decision_ms &&
+                    data->gesture_peak_velocity < cfg->gesture_min_velocity;
+    if (too_long || too_slow) {
+        data->gesture_rejected = true;
+        rejected = true;
+        // The event carries its own value, only the motion held before it is added
+        if (is_x) {
+            data->gesture_accum_x = clamp_i32((int64_t)data->gesture_accum_x - event->value);
+        } else {
+            data->gesture_accum_y = clamp_i32((int64_t)data->gesture_accum_y - event->value);
+        }
+        gesture_return_held(data);
+        goto release;
+    }
+
+    ret = ZMK_INPUT_PROC_STOP;
+
+release:
+    if (ret == ZMK_INPUT_PROC_CONTINUE) {
+        gesture_release(data, event, is_x);
+    }
+    k_spin_unlock(&data->gesture_lock, key);
+
+    if (cut_off) {
+        k_work_cancel_delayable(&data->gesture_work);
+        TRACE_DBG(data, "Gesture: left the gesture layers, passing motion through");
+    } else if (reschedule) {
+        k_work_reschedule(&data->gesture_work, K_MSEC(cfg->gesture_idle_timeout_ms));
+    }
+    if (rejected) {
+        TRACE_DBG(data, "Gesture: too %s, passing motion through", too_long ? "long" : "slow");
+    }
+
+    return ret;
+}
+#endif
+
+static void drain_pending_keypresses(void);
+
+static int scale_val(struct input_event *event, const struct scale_plan *plan,
+                     struct zmk_input_processor_state *state) {
+    // 32 x 32 bits plus the remainder cannot overflow 64 bits
+    int64_t value_mul = (int64_t)event->value * plan->mul;
 
     if (state && state->remainder) {
         value_mul += *state->remainder;
     }
 
-    int16_t scaled = value_mul / (int16_t)div;
+    int64_t scaled;
+    if (plan->div == 1) {
+        scaled = value_mul;
+    } else if (plan->shift > 0) {
+        // Bias negative values so the shift truncates toward zero like the division
+        scaled = (value_mul + (value_mul < 0 ? plan->div - 1 : 0)) >> plan->shift;
+    } else {
+        scaled = value_mul / plan->div;
+    }
 
     if (state && state->remainder) {
-        *state->remainder = value_mul - (scaled * (int16_t)div);
+        // The listener keeps 16-bit remainders, exact for divisors up to 32768
+        *state->remainder = clamp_i16(value_mul - scaled * plan->div);
     }
 
-    LOG_DBG("scaled %d with %d/%d to %d", event->value, mul, div, scaled);
-
-    event->value = scaled;
+    event->value = clamp_i32(scaled);
     return 0;
 }
 
-static int runtime_processor_handle_event(const struct device *dev, struct input_event *event,
-                                          uint32_t param1, uint32_t param2,
-                                          struct zmk_input_processor_state *state) {
+// X' = X * cos - Y * sin, Y' = X * sin + Y * cos from the last X/Y pair.
+// Right angles swap/negate exactly; other angles use cos/sin * 1000 fixed
+// point (precision: 0.001).
+static int32_t rotate_axis(const struct runtime_processor_data *data, bool is_x) {
+    switch (data->quarter_turns) {
+    case 1:
+        return is_x ? neg_sat_i32(data->last_y) : data->last_x;
+    case 3:
+        return is_x ? data->last_y : neg_sat_i32(data->last_x);
+    default:
+        break;
+    }
+
+    int64_t x = data->last_x;
+    int64_t y = data->last_y;
+    if (is_x) {
+        return clamp_i32((x * data->cos_val - y * data->sin_val) / 1000);
+    }
+    return clamp_i32((x * data->sin_val + y * data->cos_val) / 1000);
+}
+
+static int runtime_processor_process_event(const struct device *dev, struct input_event *event,
+                                           struct zmk_input_processor_state *state) {
     const struct runtime_processor_config *cfg = dev->config;
     struct runtime_processor_data *data = dev->data;
 
+    zmk_input_processor_runtime_stack_mark(ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_INPUT);
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH)
+    if (cfg->multi_touch && event->type == INPUT_EV_ABS) {
+        switch (multi_touch_process(data, event)) {
+        case MULTI_TOUCH_CONSUMED:
+            if (!event->sync) {
+                return ZMK_INPUT_PROC_STOP;
+            }
+            // Keep the frame's sync flowing to the listener on a code no
+            // processor transforms, so it cannot enter rotation pairing, snap,
+            // scaling or the history of this or a later processor
+            event->type = INPUT_EV_REL;
+            event->code = INPUT_REL_MISC;
+            event->value = 0;
+            return ZMK_INPUT_PROC_CONTINUE;
+        case MULTI_TOUCH_MOTION:
+        case MULTI_TOUCH_PASS:
+            break;
+        }
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GYRO)
+    // Angular rates become pointer deltas and continue through the transform
+    if (cfg->gyro && event->type == cfg->gyro_type) {
+        if (event->code == cfg->gyro_codes[0]) {
+            gyro_process(cfg, data, event, 0);
+        } else if (event->code == cfg->gyro_codes[1]) {
+            gyro_process(cfg, data, event, 1);
+        }
+    }
+#endif
+
     if (event->type != cfg->type) {
         return ZMK_INPUT_PROC_CONTINUE;
     }
@@ -276,13 +1286,74 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
         return ZMK_INPUT_PROC_CONTINUE;
     }
 
+    // Finish evaluating key presses still queued by the position listener, so
+    // this event sees the layer state they imply. That is key handling, so the
+    // governor does not count it as this processor's time.
+    if (!k_is_in_isr()) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+        uint32_t drain_start = k_cycle_get_32();
+        drain_pending_keypresses();
+        data->governor_excluded_cycles += k_cycle_get_32() - drain_start;
+#else
+        drain_pending_keypresses();
+#endif
+    }
+
     // Check if processor should be active for current layers
     if (!is_processor_active_for_current_layers(data->active_layers)) {
         return ZMK_INPUT_PROC_CONTINUE;
     }
 
     bool is_x = (x_idx >= 0);
-    int16_t value = event->value;
+    int32_t value = event->value;
+
+    // Drop sub-unit leftovers from before a mode switch so they cannot
+    // surface as a jump in the new mode
+    bool *remainder_reset = is_x ? &data->remainder_reset_x : &data->remainder_reset_y;
+    if (*remainder_reset) {
+        if (state && state->remainder) {
+            *state->remainder = 0;
+        }
+        *remainder_reset = false;
+    }
+
+    struct scale_plan scale_plan = data->scale_plan;
+    bool orientation_in_sensor = false;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    // Sensor already applies the closest native setting, only the residual is
+    // left for software
+    bool sensor_swap_xy = false;
+    bool sensor_invert_x = false;
+    bool sensor_invert_y = false;
+    k_spinlock_key_t offload_key = k_spin_lock(&data->sensor_offload_lock);
+    // Taken with the orientation so both belong to one sensor configuration
+    scale_plan = data->scale_plan;
+    if (data->sensor_offload_active) {
+        sensor_swap_xy = data->sensor_offload_swap_xy;
+        sensor_invert_x = data->sensor_offload_invert_x;
+        sensor_invert_y = data->sensor_offload_invert_y;
+    }
+    k_spin_unlock(&data->sensor_offload_lock, offload_key);
+
+    if (cfg->sensor_dev) {
+        bool swap_xy, invert_x, invert_y;
+        orientation_in_sensor = sensor_offload_orientation(dev, &swap_xy, &invert_x, &invert_y) &&
+                                swap_xy == sensor_swap_xy && invert_x == sensor_invert_x &&
+                                invert_y == sensor_invert_y;
+    }
+    if (!orientation_in_sensor) {
+        // The sensor has not caught up with an orientation change yet: take
+        // its swap/inversion back out and orient the event in software
+        if (is_x ? sensor_invert_x : sensor_invert_y) {
+            value = neg_sat_i32(value);
+            event->value = value;
+        }
+        if (sensor_swap_xy) {
+            is_x = !is_x;
+            event->code = is_x ? INPUT_REL_X : INPUT_REL_Y;
+        }
+    }
+#endif
 
     // Apply code mapping (XY swap and XY-to-scroll)
     // These mappings are mutually exclusive - XY-to-scroll takes precedence
@@ -291,20 +1362,20 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
         // X (0x00) -> HWHEEL (0x06), Y (0x01) -> WHEEL (0x08)
         if (is_x) {
             event->code = INPUT_REL_HWHEEL;
-            LOG_DBG("XY-to-scroll: mapped X to HWHEEL");
+            TRACE_DBG(data, "XY-to-scroll: mapped X to HWHEEL");
         } else {
             event->code = INPUT_REL_WHEEL;
-            LOG_DBG("XY-to-scroll: mapped Y to WHEEL");
+            TRACE_DBG(data, "XY-to-scroll: mapped Y to WHEEL");
         }
-    } else if (data->xy_swap_enabled) {
+    } else if (data->xy_swap_enabled && !orientation_in_sensor) {
         // Swap X and Y axes
         // X (0x00) -> Y (0x01), Y (0x01) -> X (0x00)
         if (is_x) {
             event->code = INPUT_REL_Y;
-            LOG_DBG("XY-swap: swapped X to Y");
+            TRACE_DBG(data, "XY-swap: swapped X to Y");
         } else {
             event->code = INPUT_REL_X;
-            LOG_DBG("XY-swap: swapped Y to X");
+            TRACE_DBG(data, "XY-swap: swapped Y to X");
         }
     }
 
@@ -325,19 +1396,17 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
     }
 
     // Apply rotation
-    if (data->rotation_degrees != 0) {
+    if (data->quarter_turns == 2) {
+        // 180 degrees negates each axis on its own, no X/Y pairing needed
+        event->value = neg_sat_i32(value);
+    } else if (data->quarter_turns != 0) {
         if (is_x) {
             data->last_x = value;
             data->has_x = true;
 
             // If we have both X and Y, apply rotation
             if (data->has_y) {
-                // X' = X * cos - Y * sin
-                // Using 1000 as scaling factor for fixed-point arithmetic
-                // (precision: 0.001)
-                int32_t rotated_x =
-                    (data->last_x * data->cos_val - data->last_y * data->sin_val) / 1000;
-                event->value = (int16_t)rotated_x;
+                event->value = rotate_axis(data, true);
                 data->has_y = false;
             } else {
                 event->value = 0;
@@ -348,10 +1417,7 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
 
             // If we have both X and Y, apply rotation
             if (data->has_x) {
-                // Y' = X * sin + Y * cos
-                int32_t rotated_y =
-                    (data->last_x * data->sin_val + data->last_y * data->cos_val) / 1000;
-                event->value = (int16_t)rotated_y;
+                event->value = rotate_axis(data, false);
                 data->has_x = false;
             } else {
                 event->value = 0;
@@ -360,11 +1426,34 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
     }
 
     // Apply axis inversion after rotation
-    if ((is_x && data->x_invert) || (!is_x && data->y_invert)) {
-        event->value = -event->value;
+    if (!orientation_in_sensor && ((is_x && data->x_invert) || (!is_x && data->y_invert))) {
+        event->value = neg_sat_i32(event->value);
     }
     value = event->value;
 
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY)
+    motion_history_record(&data->history, is_x, event->value, event->sync);
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    if (event->sync && !governor_degraded(data)) {
+        telemetry_update(data);
+    }
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+    // Frames the counters miss while the governor has telemetry off
+    if (event->sync && governor_degraded(data)) {
+        data->governor.skipped_telemetry_frames++;
+    }
+#endif
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE)
+    // Recognize flicks on the transformed (rotated/inverted) motion
+    if (cfg->gesture_bindings_len > 0 &&
+        gesture_process(dev, event, is_x, state) == ZMK_INPUT_PROC_STOP) {
+        return ZMK_INPUT_PROC_STOP;
+    }
+#endif
+
     // Apply axis snapping if configured
     if (data->axis_snap_mode != ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE && event->value != 0) {
         int64_t now = k_uptime_get();
@@ -381,30 +1470,28 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
                 // Decay every 50ms
                 int64_t decay_periods = elapsed / 50;
                 if (decay_periods > 0) {
-                    int16_t decay_per_50ms =
-                        data->axis_snap_threshold / (data->axis_snap_timeout_ms / 50);
+                    int32_t decay_per_50ms =
+                        data->axis_snap_threshold / MAX(data->axis_snap_timeout_ms / 50, 1);
                     if (decay_per_50ms < 1) {
                         decay_per_50ms = 1; // Minimum decay of 1
                     }
 
-                    int16_t total_decay = decay_per_50ms * decay_periods;
+                    // A long idle gap decays the whole accumulator
+                    int32_t total_decay = clamp_i32(decay_per_50ms * decay_periods);
 
                     // Decay towards zero
-                    if (data->axis_snap_cross_axis_accum > 0) {
-                        data->axis_snap_cross_axis_accum -= total_decay;
-                        if (data->axis_snap_cross_axis_accum < 0) {
-                            data->axis_snap_cross_axis_accum = 0;
-                        }
-                    } else if (data->axis_snap_cross_axis_accum < 0) {
-                        data->axis_snap_cross_axis_accum += total_decay;
-                        if (data->axis_snap_cross_axis_accum > 0) {
-                            data->axis_snap_cross_axis_accum = 0;
-                        }
+                    int32_t accum = data->axis_snap_cross_axis_accum;
+                    if (accum > 0) {
+                        data->axis_snap_cross_axis_accum =
+                            accum > total_decay ? accum - total_decay : 0;
+                    } else if (accum < 0) {
+                        data->axis_snap_cross_axis_accum =
+                            accum < -total_decay ? accum + total_decay : 0;
                     }
 
                     data->axis_snap_last_decay_timestamp = now;
-                    LOG_DBG("Axis snap: decayed accum to %d (decay=%d)",
-                            data->axis_snap_cross_axis_accum, total_decay);
+                    TRACE_DBG(data, "Axis snap: decayed accum to %d (decay=%d)",
+                              data->axis_snap_cross_axis_accum, total_decay);
                 }
             }
         }
@@ -412,43 +1499,40 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
         bool should_unlock = false;
 
         if (is_cross_axis) {
-            int16_t current_abs_accum = data->axis_snap_cross_axis_accum < 0
-                                            ? -data->axis_snap_cross_axis_accum
-                                            : data->axis_snap_cross_axis_accum;
+            int32_t current_abs_accum = abs_sat_i32(data->axis_snap_cross_axis_accum);
             bool is_unsnapped = current_abs_accum >= data->axis_snap_threshold;
 
             if (is_unsnapped) {
                 // Just increase accumulator when already unsnapped
-                data->axis_snap_cross_axis_accum = current_abs_accum + (value > 0 ? value : -value);
+                data->axis_snap_cross_axis_accum =
+                    clamp_i32((int64_t)current_abs_accum + abs_sat_i32(value));
             } else {
                 // Accumulate normally when snapped (no abs)
-                data->axis_snap_cross_axis_accum += value;
+                data->axis_snap_cross_axis_accum =
+                    clamp_i32((int64_t)data->axis_snap_cross_axis_accum + value);
             }
             // Reset decay timer on movement
             data->axis_snap_last_decay_timestamp = now;
 
             // Check if threshold exceeded (check absolute value)
-            int16_t abs_accum = data->axis_snap_cross_axis_accum < 0
-                                    ? -data->axis_snap_cross_axis_accum
-                                    : data->axis_snap_cross_axis_accum;
+            int32_t abs_accum = abs_sat_i32(data->axis_snap_cross_axis_accum);
 
             if (abs_accum >= data->axis_snap_threshold) {
-                LOG_DBG("Axis snap: unlocked (threshold=%d exceeded with accum=%d)",
-                        data->axis_snap_threshold, data->axis_snap_cross_axis_accum);
+                TRACE_DBG(data, "Axis snap: unlocked (threshold=%d exceeded with accum=%d)",
+                          data->axis_snap_threshold, data->axis_snap_cross_axis_accum);
                 // cap the accumulator to twice the threshold so that it decays
                 // under threshold within timeout
-                if (abs_accum > data->axis_snap_threshold * 2) {
+                int32_t cap = (int32_t)data->axis_snap_threshold * 2;
+                if (abs_accum > cap) {
                     data->axis_snap_cross_axis_accum =
-                        (data->axis_snap_cross_axis_accum > 0 ? data->axis_snap_threshold
-                                                              : -data->axis_snap_threshold) *
-                        2;
+                        data->axis_snap_cross_axis_accum > 0 ? cap : -cap;
                 }
             } else {
                 // Suppress cross-axis movement while locked
                 event->value = 0;
-                LOG_DBG("Axis snap: suppressing cross-axis movement (accum=%d, "
-                        "threshold=%d)",
-                        data->axis_snap_cross_axis_accum, data->axis_snap_threshold);
+                TRACE_DBG(data,
+                          "Axis snap: suppressing cross-axis movement (accum=%d, threshold=%d)",
+                          data->axis_snap_cross_axis_accum, data->axis_snap_threshold);
             }
         }
 
@@ -457,10 +1541,10 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
     }
 
     // Apply scaling
-    if (data->scale_multiplier > 0 && data->scale_divisor > 0) {
-        scale_val(event, data->scale_multiplier, data->scale_divisor, state);
-        value = event->value;
-    }
+    scale_val(event, &scale_plan, state);
+    TRACE_DBG(data, "scaled %d with %d/%d to %d", value, scale_plan.mul, scale_plan.div,
+              event->value);
+    value = event->value;
 
     // Schedule deactivation after input stops
     if (data->temp_layer_enabled && data->temp_layer_layer_active &&
@@ -472,27 +1556,70 @@ static int runtime_processor_handle_event(const struct device *dev, struct input
     return ZMK_INPUT_PROC_CONTINUE;
 }
 
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+// Track the handler time with a moving average. Over budget, the optional
+// stages are turned off; they come back once the average has dropped below
+// the recovery level and the hold time has passed, so a handler running close
+// to its budget does not toggle on every event.
+static void governor_update(const struct device *dev, uint32_t cycles) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+    struct zmk_input_processor_runtime_governor *governor = &data->governor;
+
+    uint32_t us = k_cyc_to_us_floor32(cycles);
+    // Cap a single sample (e.g. the thread preempted for long) so the average
+    // stays in range and recovers within a few events
+    us = MIN(us, CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR_BUDGET_US * 16);
+    int32_t diff = (int32_t)(us * 16) - (int32_t)data->governor_average_q4;
+    data->governor_average_q4 += diff / 8;
+    governor->average_us = data->governor_average_q4 / 16;
+    governor->peak_us = MAX(governor->peak_us, us);
+
+    if (governor->degraded) {
+        governor->degraded_events++;
+        if (governor->average_us * 100 <=
+                CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR_BUDGET_US *
+                    CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR_RECOVER_PERCENT &&
+            k_uptime_get() - data->governor_degraded_timestamp >=
+                CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR_HOLD_MS) {
+            governor->degraded = false;
+            LOG_INF("Governor: %s back within budget (%d us), optional stages restored",
+                    cfg->name, governor->average_us);
+        }
+    } else if (governor->average_us > CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR_BUDGET_US) {
+        governor->degraded = true;
+        governor->degradations++;
+        data->governor_degraded_timestamp = k_uptime_get();
+        LOG_WRN("Governor: %s over budget (%d us > %d us), optional stages off (#%d)", cfg->name,
+                governor->average_us, CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR_BUDGET_US,
+                governor->degradations);
+    }
+}
+#endif
+
+static int runtime_processor_handle_event(const struct device *dev, struct input_event *event,
+                                          uint32_t param1, uint32_t param2,
+                                          struct zmk_input_processor_state *state) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+    struct runtime_processor_data *data = dev->data;
+
+    data->governor_excluded_cycles = 0;
+    uint32_t start = k_cycle_get_32();
+    int ret = runtime_processor_process_event(dev, event, state);
+    governor_update(dev, k_cycle_get_32() - start - data->governor_excluded_cycles);
+    return ret;
+#else
+    return runtime_processor_process_event(dev, event, state);
+#endif
+}
+
 static struct zmk_input_processor_driver_api runtime_processor_driver_api = {
     .handle_event = runtime_processor_handle_event,
 };
 
 #if IS_ENABLED(CONFIG_SETTINGS)
 struct processor_settings {
-    uint32_t scale_multiplier;
-    uint32_t scale_divisor;
-    int32_t rotation_degrees;
-    bool temp_layer_enabled;
-    uint8_t temp_layer_layer;
-    uint16_t temp_layer_activation_delay_ms;
-    uint16_t temp_layer_deactivation_delay_ms;
-    uint32_t active_layers;
-    uint8_t axis_snap_mode;
-    uint16_t axis_snap_threshold;
-    uint16_t axis_snap_timeout_ms;
-    bool xy_to_scroll_enabled;
-    bool xy_swap_enabled;
-    bool x_invert;
-    bool y_invert;
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(ZMK_INPUT_PROCESSOR_RUNTIME_FIELD_DECLARE)
 };
 
 static void save_processor_settings_work_handler(struct k_work *work) {
@@ -502,23 +1629,12 @@ static void save_processor_settings_work_handler(struct k_work *work) {
     const struct device *dev = data->dev;
     const struct runtime_processor_config *cfg = dev->config;
 
-    struct processor_settings settings = {
-        .scale_multiplier = data->persistent_scale_multiplier,
-        .scale_divisor = data->persistent_scale_divisor,
-        .rotation_degrees = data->persistent_rotation_degrees,
-        .temp_layer_enabled = data->persistent_temp_layer_enabled,
-        .temp_layer_layer = data->persistent_temp_layer_layer,
-        .temp_layer_activation_delay_ms = data->persistent_temp_layer_activation_delay_ms,
-        .temp_layer_deactivation_delay_ms = data->persistent_temp_layer_deactivation_delay_ms,
-        .active_layers = data->persistent_active_layers,
-        .axis_snap_mode = data->persistent_axis_snap_mode,
-        .axis_snap_threshold = data->persistent_axis_snap_threshold,
-        .axis_snap_timeout_ms = data->persistent_axis_snap_timeout_ms,
-        .xy_to_scroll_enabled = data->persistent_xy_to_scroll_enabled,
-        .xy_swap_enabled = data->persistent_xy_swap_enabled,
-        .x_invert = data->persistent_x_invert,
-        .y_invert = data->persistent_y_invert,
-    };
+    zmk_input_processor_runtime_stack_mark(ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_WORK);
+
+    // Zeroed first so padding bytes are stored deterministically
+    struct processor_settings settings;
+    memset(&settings, 0, sizeof(settings));
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_PERSISTENT, &settings, data)
 
     char path[64];
     snprintf(path, sizeof(path), "input_proc/%s", cfg->name);
@@ -546,41 +1662,11 @@ static int load_processor_settings_cb(const char *name, size_t len, settings_rea
         struct processor_settings settings;
         int rc = read_cb(cb_arg, &settings, sizeof(settings));
         if (rc >= 0) {
-            data->persistent_scale_multiplier = settings.scale_multiplier;
-            data->persistent_scale_divisor = settings.scale_divisor;
-            data->persistent_rotation_degrees = settings.rotation_degrees;
-            data->persistent_temp_layer_enabled = settings.temp_layer_enabled;
-            data->persistent_temp_layer_layer = settings.temp_layer_layer;
-            data->persistent_temp_layer_activation_delay_ms =
-                settings.temp_layer_activation_delay_ms;
-            data->persistent_temp_layer_deactivation_delay_ms =
-                settings.temp_layer_deactivation_delay_ms;
-            data->persistent_active_layers = settings.active_layers;
-            data->persistent_axis_snap_mode = settings.axis_snap_mode;
-            data->persistent_axis_snap_threshold = settings.axis_snap_threshold;
-            data->persistent_axis_snap_timeout_ms = settings.axis_snap_timeout_ms;
-            data->persistent_xy_to_scroll_enabled = settings.xy_to_scroll_enabled;
-            data->persistent_xy_swap_enabled = settings.xy_swap_enabled;
-            data->persistent_x_invert = settings.x_invert;
-            data->persistent_y_invert = settings.y_invert;
-
-            // Apply to current values
-            data->scale_multiplier = settings.scale_multiplier;
-            data->scale_divisor = settings.scale_divisor;
-            data->rotation_degrees = settings.rotation_degrees;
-            data->temp_layer_enabled = settings.temp_layer_enabled;
-            data->temp_layer_layer = settings.temp_layer_layer;
-            data->temp_layer_activation_delay_ms = settings.temp_layer_activation_delay_ms;
-            data->temp_layer_deactivation_delay_ms = settings.temp_layer_deactivation_delay_ms;
-            data->active_layers = settings.active_layers;
-            data->axis_snap_mode = settings.axis_snap_mode;
-            data->axis_snap_threshold = settings.axis_snap_threshold;
-            data->axis_snap_timeout_ms = settings.axis_snap_timeout_ms;
-            data->xy_to_scroll_enabled = settings.xy_to_scroll_enabled;
-            data->xy_swap_enabled = settings.xy_swap_enabled;
-            data->x_invert = settings.x_invert;
-            data->y_invert = settings.y_invert;
+            // Apply to persistent and current values
+            ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_LOAD, data, &settings)
             update_rotation_values(data);
+            update_scale(dev);
+            schedule_sensor_offload(dev);
 
             LOG_INF("Loaded settings for %s: scale=%d/%d, rotation=%d, "
                     "temp_layer=%d, active_layers=0x%08x, axis_snap=%d",
@@ -598,38 +1684,31 @@ static int runtime_processor_settings_load_cb(const char *name, size_t len,
 
 SETTINGS_STATIC_HANDLER_DEFINE(input_proc, "input_proc", NULL, runtime_processor_settings_load_cb,
                                NULL, NULL);
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+static int telemetry_settings_load_cb(const char *name, size_t len, settings_read_cb read_cb,
+                                      void *cb_arg);
+
+SETTINGS_STATIC_HANDLER_DEFINE(input_proc_tm, "input_proc_tm", NULL, telemetry_settings_load_cb,
+                               NULL, NULL);
+#endif
 #endif
 
 static int runtime_processor_init(const struct device *dev) {
     const struct runtime_processor_config *cfg = dev->config;
     struct runtime_processor_data *data = dev->data;
 
-    // Initialize with default values
-    data->scale_multiplier = cfg->initial_scale_multiplier;
-    data->scale_divisor = cfg->initial_scale_divisor;
-    data->rotation_degrees = cfg->initial_rotation_degrees;
-
-    // Initialize persistent values same as current
-    data->persistent_scale_multiplier = cfg->initial_scale_multiplier;
-    data->persistent_scale_divisor = cfg->initial_scale_divisor;
-    data->persistent_rotation_degrees = cfg->initial_rotation_degrees;
+    // Initialize current and persistent values from DT defaults
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_RESET, data, cfg)
 
     // Initialize rotation state
     data->has_x = false;
     data->has_y = false;
     data->last_x = 0;
     data->last_y = 0;
+    data->remainder_reset_x = false;
+    data->remainder_reset_y = false;
 
-    // Initialize temp-layer settings from DT defaults
-    data->temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->temp_layer_deactivation_delay_ms = cfg->initial_temp_layer_deactivation_delay_ms;
-    data->persistent_temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->persistent_temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->persistent_temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->persistent_temp_layer_deactivation_delay_ms =
-        cfg->initial_temp_layer_deactivation_delay_ms;
 
     // Initialize temp-layer runtime state
     data->temp_layer_layer_active = false;
@@ -637,33 +1716,10 @@ static int runtime_processor_init(const struct device *dev) {
     data->last_input_timestamp = 0;
     data->last_keypress_timestamp = 0;
 
-    // Initialize active layers from DT defaults
-    data->active_layers = cfg->initial_active_layers;
-    data->persistent_active_layers = cfg->initial_active_layers;
-
-    // Initialize axis snap settings from DT defaults
-    data->axis_snap_mode = cfg->initial_axis_snap_mode;
-    data->axis_snap_threshold = cfg->initial_axis_snap_threshold;
-    data->axis_snap_timeout_ms = cfg->initial_axis_snap_timeout_ms;
-    data->persistent_axis_snap_mode = cfg->initial_axis_snap_mode;
-    data->persistent_axis_snap_threshold = cfg->initial_axis_snap_threshold;
-    data->persistent_axis_snap_timeout_ms = cfg->initial_axis_snap_timeout_ms;
-
     // Initialize axis snap runtime state
     data->axis_snap_cross_axis_accum = 0;
     data->axis_snap_last_decay_timestamp = 0;
 
-    // Initialize code mapping settings from DT defaults
-    data->xy_to_scroll_enabled = cfg->initial_xy_to_scroll_enabled;
-    data->xy_swap_enabled = cfg->initial_xy_swap_enabled;
-    data->persistent_xy_to_scroll_enabled = cfg->initial_xy_to_scroll_enabled;
-    data->persistent_xy_swap_enabled = cfg->initial_xy_swap_enabled;
-    // Initialize axis invert settings from DT defaults
-    data->x_invert = cfg->initial_x_invert;
-    data->y_invert = cfg->initial_y_invert;
-    data->persistent_x_invert = cfg->initial_x_invert;
-    data->persistent_y_invert = cfg->initial_y_invert;
-
     update_rotation_values(data);
 
     data->dev = dev;
@@ -675,6 +1731,58 @@ static int runtime_processor_init(const struct device *dev) {
     k_work_init_delayable(&data->temp_layer_deactivation_work,
                           temp_layer_deactivation_work_handler);
 
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    k_work_init(&data->sensor_offload_work, sensor_offload_work_handler);
+    data->sensor_offload_active = false;
+    data->sensor_programmed = false;
+#endif
+    update_scale(dev);
+    schedule_sensor_offload(dev);
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY)
+    memset(&data->history, 0, sizeof(data->history));
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    memset(&data->telemetry, 0, sizeof(data->telemetry));
+    data->telemetry_level_q4 = 0;
+    data->telemetry_zero_run = 0;
+#if TELEMETRY_SAVE
+    k_work_init_delayable(&data->telemetry_save_work, telemetry_save_work_handler);
+#endif
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GYRO)
+    for (int i = 0; i < 2; i++) {
+        data->gyro_bias_q8[i] = 0;
+        data->gyro_smooth_q8[i] = 0;
+        data->gyro_remainder_q8[i] = 0;
+        data->gyro_settled[i] = 0;
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE)
+    k_work_init_delayable(&data->gesture_work, gesture_work_handler);
+    data->gesture_tracking = false;
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH)
+    data->mt_slot = 0;
+    data->mt_active = 0;
+    data->mt_has_x = 0;
+    data->mt_has_y = 0;
+    data->mt_contacts = 0;
+    data->mt_scroll_remainder_x = 0;
+    data->mt_scroll_remainder_y = 0;
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+    memset(&data->governor, 0, sizeof(data->governor));
+    data->governor.budget_us = CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR_BUDGET_US;
+    data->governor_average_q4 = 0;
+    data->governor_excluded_cycles = 0;
+#endif
+
     LOG_INF("Runtime processor '%s' initialized", cfg->name);
 
     return 0;
@@ -694,6 +1802,20 @@ static void raise_state_changed_event(const struct device *dev) {
         (struct zmk_input_processor_state_changed){.name = name, .config = config});
 }
 
+// Clear per-stroke state so a mode switch starts from a clean slate
+static void reset_motion_state(struct runtime_processor_data *data) {
+    data->axis_snap_cross_axis_accum = 0;
+    data->axis_snap_last_decay_timestamp = 0;
+    data->has_x = false;
+    data->has_y = false;
+    data->remainder_reset_x = true;
+    data->remainder_reset_y = true;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY)
+    data->history.pending_dx = 0;
+    data->history.pending_dy = 0;
+#endif
+}
+
 // Public API for runtime configuration
 int zmk_input_processor_runtime_set_scaling(const struct device *dev, uint32_t multiplier,
                                             uint32_t divisor, bool persistent) {
@@ -703,6 +1825,13 @@ int zmk_input_processor_runtime_set_scaling(const struct device *dev, uint32_t m
 
     struct runtime_processor_data *data = dev->data;
 
+    // Values of 0 keep the current term; the resulting ratio must reduce to
+    // 31-bit terms or scaling would change it
+    if (!scale_fits(multiplier > 0 ? multiplier : data->scale_multiplier,
+                    divisor > 0 ? divisor : data->scale_divisor)) {
+        return -EINVAL;
+    }
+
     if (multiplier > 0) {
         data->scale_multiplier = multiplier;
         if (persistent) {
@@ -716,8 +1845,10 @@ int zmk_input_processor_runtime_set_scaling(const struct device *dev, uint32_t m
         }
     }
 
+    update_scale(dev);
     LOG_INF("Set scaling to %d/%d%s", data->scale_multiplier, data->scale_divisor,
             persistent ? " (persistent)" : " (temporary)");
+    schedule_sensor_offload(dev);
 
     int ret = 0;
 #if IS_ENABLED(CONFIG_SETTINGS)
@@ -743,6 +1874,10 @@ int zmk_input_processor_runtime_set_rotation(const struct device *dev, int32_t d
         data->persistent_rotation_degrees = degrees;
     }
     update_rotation_values(data);
+    // A half X/Y pair from the old angle must not pair with the new one
+    data->has_x = false;
+    data->has_y = false;
+    schedule_sensor_offload(dev);
 
     LOG_INF("Set rotation to %d degrees%s", degrees, persistent ? " (persistent)" : " (temporary)");
 
@@ -766,43 +1901,18 @@ int zmk_input_processor_runtime_reset(const struct device *dev) {
     const struct runtime_processor_config *cfg = dev->config;
     struct runtime_processor_data *data = dev->data;
 
-    // Reset to initial values
-    data->scale_multiplier = cfg->initial_scale_multiplier;
-    data->scale_divisor = cfg->initial_scale_divisor;
-    data->rotation_degrees = cfg->initial_rotation_degrees;
-
-    data->persistent_scale_multiplier = cfg->initial_scale_multiplier;
-    data->persistent_scale_divisor = cfg->initial_scale_divisor;
-    data->persistent_rotation_degrees = cfg->initial_rotation_degrees;
-
-    // Reset temp-layer settings to defaults
-    data->temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->temp_layer_deactivation_delay_ms = cfg->initial_temp_layer_deactivation_delay_ms;
-    data->persistent_temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->persistent_temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->persistent_temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->persistent_temp_layer_deactivation_delay_ms =
-        cfg->initial_temp_layer_deactivation_delay_ms;
-
-    // Reset active layers to defaults
-    data->active_layers = cfg->initial_active_layers;
-    data->persistent_active_layers = cfg->initial_active_layers;
-
     // Deactivate temp-layer layer if active
     if (data->temp_layer_layer_active) {
         zmk_keymap_layer_deactivate(data->temp_layer_layer);
         data->temp_layer_layer_active = false;
     }
 
-    // Reset axis invert settings to defaults
-    data->x_invert = cfg->initial_x_invert;
-    data->y_invert = cfg->initial_y_invert;
-    data->persistent_x_invert = cfg->initial_x_invert;
-    data->persistent_y_invert = cfg->initial_y_invert;
+    // Reset current and persistent values to DT defaults
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_RESET, data, cfg)
 
     update_rotation_values(data);
+    update_scale(dev);
+    schedule_sensor_offload(dev);
 
     LOG_INF("Reset processor '%s' to defaults", cfg->name);
 
@@ -823,27 +1933,50 @@ void zmk_input_processor_runtime_restore_persistent(const struct device *dev) {
 
     struct runtime_processor_data *data = dev->data;
 
+    k_sched_lock();
+
     // Restore persistent values (used after temporary behavior changes)
-    data->scale_multiplier = data->persistent_scale_multiplier;
-    data->scale_divisor = data->persistent_scale_divisor;
-    data->rotation_degrees = data->persistent_rotation_degrees;
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_RESTORE, data)
     update_rotation_values(data);
 
-    // Restore axis snap settings
-    data->axis_snap_mode = data->persistent_axis_snap_mode;
-    data->axis_snap_threshold = data->persistent_axis_snap_threshold;
-    data->axis_snap_timeout_ms = data->persistent_axis_snap_timeout_ms;
-    // Reset snap state when restoring
-    data->axis_snap_cross_axis_accum = 0;
-    data->axis_snap_last_decay_timestamp = 0;
+    // Reset snap, rotation and remainder state when restoring
+    reset_motion_state(data);
+    update_scale(dev);
+    schedule_sensor_offload(dev);
 
-    // Restore axis invert settings
-    data->x_invert = data->persistent_x_invert;
-    data->y_invert = data->persistent_y_invert;
+    k_sched_unlock();
 
     LOG_DBG("Restored persistent values");
 }
 
+int zmk_input_processor_runtime_enter_scroll_mode(
+    const struct device *dev, const struct zmk_input_processor_runtime_scroll_mode *mode) {
+    if (!dev || !mode || !scale_fits(mode->scale_multiplier, mode->scale_divisor)) {
+        return -EINVAL;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    // The input thread must never see a half-switched mode (e.g. scroll
+    // mapping with the pointer scale). With sensor offload, the residual
+    // switches here too, for the CPI the sensor runs at until reprogrammed.
+    k_sched_lock();
+    data->xy_to_scroll_enabled = true;
+    data->scale_multiplier = mode->scale_multiplier;
+    data->scale_divisor = mode->scale_divisor;
+    data->axis_snap_mode = mode->axis_snap_mode;
+    data->axis_snap_threshold = mode->axis_snap_threshold;
+    data->axis_snap_timeout_ms = mode->axis_snap_timeout_ms;
+    reset_motion_state(data);
+    update_scale(dev);
+    schedule_sensor_offload(dev);
+    k_sched_unlock();
+
+    LOG_INF("Entered scroll mode: scale=%d/%d, snap=%d (temporary)", mode->scale_multiplier,
+            mode->scale_divisor, mode->axis_snap_mode);
+    return 0;
+}
+
 int zmk_input_processor_runtime_get_config(const struct device *dev, const char **name,
                                            struct zmk_input_processor_runtime_config *config) {
     if (!dev) {
@@ -857,27 +1990,116 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
         *name = cfg->name;
     }
     if (config) {
-        config->scale_multiplier = data->persistent_scale_multiplier;
-        config->scale_divisor = data->persistent_scale_divisor;
-        config->rotation_degrees = data->persistent_rotation_degrees;
-        config->temp_layer_enabled = data->persistent_temp_layer_enabled;
-        config->temp_layer_layer = data->persistent_temp_layer_layer;
-        config->temp_layer_activation_delay_ms = data->persistent_temp_layer_activation_delay_ms;
-        config->temp_layer_deactivation_delay_ms =
-            data->persistent_temp_layer_deactivation_delay_ms;
-        config->active_layers = data->persistent_active_layers;
-        config->axis_snap_mode = data->persistent_axis_snap_mode;
-        config->axis_snap_threshold = data->persistent_axis_snap_threshold;
-        config->axis_snap_timeout_ms = data->persistent_axis_snap_timeout_ms;
-        config->xy_to_scroll_enabled = data->persistent_xy_to_scroll_enabled;
-        config->xy_swap_enabled = data->persistent_xy_swap_enabled;
-        config->x_invert = data->persistent_x_invert;
-        config->y_invert = data->persistent_y_invert;
+        ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_PERSISTENT, config, data)
+    }
+
+    return 0;
+}
+
+int zmk_input_processor_runtime_get_telemetry(
+    const struct device *dev, struct zmk_input_processor_runtime_telemetry *telemetry) {
+    if (!dev || !telemetry) {
+        return -EINVAL;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    struct runtime_processor_data *data = dev->data;
+    // The 64-bit distance is not copied atomically; keep the event path out
+    k_sched_lock();
+    *telemetry = data->telemetry;
+    k_sched_unlock();
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+int zmk_input_processor_runtime_reset_telemetry(const struct device *dev) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    struct runtime_processor_data *data = dev->data;
+    const struct runtime_processor_config *cfg = dev->config;
+    k_sched_lock();
+    memset(&data->telemetry, 0, sizeof(data->telemetry));
+    data->telemetry_zero_run = 0;
+    k_sched_unlock();
+
+    LOG_INF("Reset telemetry for %s", cfg->name);
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+    k_work_reschedule(&data->telemetry_save_work, K_NO_WAIT);
+#elif IS_ENABLED(CONFIG_SETTINGS)
+    k_work_reschedule(&data->telemetry_save_work, K_MSEC(CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE));
+#endif
+    return 0;
+#else
+    return -ENOTSUP;
+#endif
+}
+
+int zmk_input_processor_runtime_get_governor(
+    const struct device *dev, struct zmk_input_processor_runtime_governor *governor) {
+    if (!dev || !governor) {
+        return -EINVAL;
     }
 
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GOVERNOR)
+    struct runtime_processor_data *data = dev->data;
+    // Updated field by field on the event path; keep it out while copying
+    k_sched_lock();
+    *governor = data->governor;
+    k_sched_unlock();
     return 0;
+#else
+    return -ENOTSUP;
+#endif
 }
 
+#define RUNTIME_SENSOR_OFFLOAD_CFG(n)                                                              \
+    .sensor_dev = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, sensor_device),                             \
+                              (DEVICE_DT_GET(DT_INST_PHANDLE(n, sensor_device))), (NULL)),         \
+    .sensor_cpi = DT_INST_PROP_OR(n, sensor_cpi, 0),                                               \
+    .sensor_cpi_min = DT_INST_PROP_OR(n, sensor_cpi_min, 100),                                     \
+    .sensor_cpi_max = DT_INST_PROP_OR(n, sensor_cpi_max, 12000),                                   \
+    .sensor_cpi_step = DT_INST_PROP_OR(n, sensor_cpi_step, 100),                                   \
+    .sensor_cpi_attr = DT_INST_PROP_OR(n, sensor_cpi_attr, -1),                                    \
+    .sensor_swap_xy_attr = DT_INST_PROP_OR(n, sensor_swap_xy_attr, -1),                            \
+    .sensor_invert_x_attr = DT_INST_PROP_OR(n, sensor_invert_x_attr, -1),                          \
+    .sensor_invert_y_attr = DT_INST_PROP_OR(n, sensor_invert_y_attr, -1),
+
+#define RUNTIME_GYRO_CFG(n)                                                                        \
+    .gyro = DT_INST_NODE_HAS_PROP(n, gyro_codes),                                                  \
+    .gyro_type = DT_INST_PROP_OR(n, gyro_type, INPUT_EV_ABS),                                      \
+    .gyro_codes = {DT_INST_PROP_BY_IDX_OR(n, gyro_codes, 0, 0),                                    \
+                   DT_INST_PROP_BY_IDX_OR(n, gyro_codes, 1, 0)},                                   \
+    .gyro_deadzone = DT_INST_PROP_OR(n, gyro_deadzone, 2),                                         \
+    .gyro_rest_threshold = DT_INST_PROP_OR(n, gyro_rest_threshold, 20),                            \
+    .gyro_bias_shift = DT_INST_PROP_OR(n, gyro_bias_shift, 6),                                     \
+    .gyro_smoothing_shift = DT_INST_PROP_OR(n, gyro_smoothing_shift, 2),
+
+#define RUNTIME_GESTURE_BINDING(idx, n)                                                            \
+    {                                                                                              \
+        .behavior_dev = DEVICE_DT_NAME(DT_INST_PHANDLE_BY_IDX(n, gesture_bindings, idx)),          \
+        .param1 = COND_CODE_0(DT_INST_PHA_HAS_CELL_AT_IDX(n, gesture_bindings, idx, param1), (0),  \
+                              (DT_INST_PHA_BY_IDX(n, gesture_bindings, idx, param1))),             \
+        .param2 = COND_CODE_0(DT_INST_PHA_HAS_CELL_AT_IDX(n, gesture_bindings, idx, param2), (0),  \
+                              (DT_INST_PHA_BY_IDX(n, gesture_bindings, idx, param2))),             \
+    }
+
+#define RUNTIME_GESTURE_CFG(n)                                                                     \
+    .gesture_bindings = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, gesture_bindings),                    \
+                                    (runtime_gesture_bindings_##n), (NULL)),                       \
+    .gesture_bindings_len = DT_INST_PROP_LEN_OR(n, gesture_bindings, 0),                           \
+    .gesture_layers = DT_INST_PROP_OR(n, gesture_layers, 0),                                       \
+    .gesture_min_distance = DT_INST_PROP_OR(n, gesture_min_distance, 200),                         \
+    .gesture_min_velocity = DT_INST_PROP_OR(n, gesture_min_velocity, 2000),                        \
+    .gesture_decision_ms = DT_INST_PROP_OR(n, gesture_decision_ms, 20),                            \
+    .gesture_max_duration_ms = DT_INST_PROP_OR(n, gesture_max_duration_ms, 300),                   \
+    .gesture_idle_timeout_ms = DT_INST_PROP_OR(n, gesture_idle_timeout_ms, 50),
+
 #define RUNTIME_PROCESSOR_INST(n)                                                                  \
     static const uint16_t runtime_x_codes_##n[] = DT_INST_PROP(n, x_codes);                        \
     static const uint16_t runtime_y_codes_##n[] = DT_INST_PROP(n, y_codes);                        \
@@ -887,6 +2109,27 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
                 (static const uint16_t runtime_temp_layer_keep_keycodes_##n[] =                    \
                      DT_INST_PROP(n, temp_layer_keep_keycodes);),                                  \
                 ())                                                                                \
+    IF_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE,                                         \
+               (COND_CODE_1(DT_INST_NODE_HAS_PROP(n, gesture_bindings),                            \
+                            (static const struct zmk_behavior_binding                              \
+                                 runtime_gesture_bindings_##n[] = {LISTIFY(                        \
+                                     DT_INST_PROP_LEN(n, gesture_bindings),                        \
+                                     RUNTIME_GESTURE_BINDING, (, ), n)};),                         \
+                            ())))                                                                  \
+    BUILD_ASSERT(DT_INST_PROP_LEN_OR(n, gyro_codes, 2) == 2,                                       \
+                 "gyro-codes needs exactly 2 codes (pointer X rate, pointer Y rate)");             \
+    BUILD_ASSERT(DT_INST_PROP_OR(n, gyro_bias_shift, 6) < 16 &&                                    \
+                     DT_INST_PROP_OR(n, gyro_smoothing_shift, 2) < 16,                             \
+                 "gyro filter shifts must be below 16");                                           \
+    BUILD_ASSERT(DT_INST_PROP_LEN_OR(n, gesture_bindings, 4) == 4,                                 \
+                 "gesture-bindings needs exactly 4 bindings (up, down, left, right)");             \
+    BUILD_ASSERT(!DT_INST_NODE_HAS_PROP(n, gesture_bindings) ||                                    \
+                     DT_INST_PROP_OR(n, gesture_layers, 0) != 0,                                   \
+                 "gesture-bindings requires gesture-layers");                                      \
+    BUILD_ASSERT(!DT_INST_NODE_HAS_PROP(n, sensor_device) ||                                       \
+                     (DT_INST_PROP_OR(n, sensor_cpi, 0) > 0 &&                                     \
+                      DT_INST_PROP_OR(n, sensor_cpi_step, 100) > 0),                               \
+                 "sensor-device requires sensor-cpi and a non-zero sensor-cpi-step");              \
     BUILD_ASSERT(sizeof(DT_INST_PROP(n, processor_label)) <=                                       \
                      CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_NAME_MAX_LEN,                              \
                  "processor_label " DT_INST_PROP(                                                  \
@@ -900,9 +2143,7 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
         .y_codes_len = DT_INST_PROP_LEN(n, y_codes),                                               \
         .x_codes = runtime_x_codes_##n,                                                            \
         .y_codes = runtime_y_codes_##n,                                                            \
-        .initial_scale_multiplier = DT_INST_PROP_OR(n, scale_multiplier, 1),                       \
-        .initial_scale_divisor = DT_INST_PROP_OR(n, scale_divisor, 1),                             \
-        .initial_rotation_degrees = DT_INST_PROP_OR(n, rotation_degrees, 0),                       \
+        ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(RUNTIME_FIELD_DT, n)                                    \
         .temp_layer_transparent_behavior = COND_CODE_1(                                            \
             DT_INST_NODE_HAS_PROP(n, temp_layer_transparent_behavior),                             \
             (DEVICE_DT_GET(DT_INST_PHANDLE(n, temp_layer_transparent_behavior))), (NULL)),         \
@@ -915,20 +2156,12 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
         .temp_layer_keep_keycodes =                                                                \
             COND_CODE_1(DT_INST_NODE_HAS_PROP(n, temp_layer_keep_keycodes),                        \
                         (runtime_temp_layer_keep_keycodes_##n), (NULL)),                           \
-        .initial_temp_layer_enabled = DT_INST_PROP(n, temp_layer_enabled),                         \
-        .initial_temp_layer_layer = DT_INST_PROP_OR(n, temp_layer, 0),                             \
-        .initial_temp_layer_activation_delay_ms =                                                  \
-            DT_INST_PROP_OR(n, temp_layer_activation_delay_ms, 100),                               \
-        .initial_temp_layer_deactivation_delay_ms =                                                \
-            DT_INST_PROP_OR(n, temp_layer_deactivation_delay_ms, 500),                             \
-        .initial_active_layers = DT_INST_PROP_OR(n, active_layers, 0),                             \
-        .initial_axis_snap_mode = DT_INST_PROP_OR(n, axis_snap_mode, 0),                           \
-        .initial_axis_snap_threshold = DT_INST_PROP_OR(n, axis_snap_threshold, 100),               \
-        .initial_axis_snap_timeout_ms = DT_INST_PROP_OR(n, axis_snap_timeout_ms, 1000),            \
-        .initial_xy_to_scroll_enabled = DT_INST_PROP(n, xy_to_scroll_enabled),                     \
-        .initial_xy_swap_enabled = DT_INST_PROP(n, xy_swap_enabled),                               \
-        .initial_x_invert = DT_INST_PROP(n, x_invert),                                             \
-        .initial_y_invert = DT_INST_PROP(n, y_invert),                                             \
+        IF_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD,                              \
+                   (RUNTIME_SENSOR_OFFLOAD_CFG(n)))                                                \
+        IF_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_MULTI_TOUCH,                                 \
+                   (.multi_touch = DT_INST_PROP(n, multi_touch), ))                                \
+        IF_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GYRO, (RUNTIME_GYRO_CFG(n)))                 \
+        IF_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE, (RUNTIME_GESTURE_CFG(n)))           \
     };                                                                                             \
     static struct runtime_processor_data runtime_data_##n;                                         \
     DEVICE_DT_INST_DEFINE(n, &runtime_processor_init, NULL, &runtime_data_##n,                     \
@@ -1004,6 +2237,107 @@ static int runtime_processor_settings_load_cb(const char *name, size_t len,
     return -ENOENT;
 }
 
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+static int telemetry_settings_load_cb(const char *name, size_t len, settings_read_cb read_cb,
+                                      void *cb_arg) {
+    for (size_t i = 0; i < runtime_processors_count; i++) {
+        const struct device *dev = runtime_processors[i];
+        const struct runtime_processor_config *cfg = dev->config;
+        struct runtime_processor_data *data = dev->data;
+        if (strcmp(name, cfg->name) != 0) {
+            continue;
+        }
+        if (len != sizeof(data->telemetry)) {
+            return -EINVAL;
+        }
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+        // Saved before the record ring was enabled: take the counters over
+        // unless the ring already has some, and move them to the ring once
+        // the load is over
+        struct zmk_input_processor_runtime_telemetry telemetry;
+        int rc = read_cb(cb_arg, &telemetry, sizeof(telemetry));
+        if (rc < 0) {
+            return rc;
+        }
+        if (!data->telemetry_from_ring) {
+            data->telemetry = telemetry;
+        }
+        data->telemetry_in_settings = true;
+        k_work_reschedule(&data->telemetry_save_work, K_MSEC(CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE));
+        return 0;
+#else
+        int rc = read_cb(cb_arg, &data->telemetry, sizeof(data->telemetry));
+        return rc < 0 ? rc : 0;
+#endif
+    }
+    return -ENOENT;
+}
+#endif
+
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY) &&                                   \
+    IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING)
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) <=
+                 CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING_MAX_KEYS,
+             "Each runtime input processor needs a record ring key for its telemetry");
+BUILD_ASSERT(sizeof(struct telemetry_ring_record) <=
+                 CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING_MAX_LEN,
+             "Telemetry does not fit in a record ring record");
+
+// Flash is not ready when the processors are initialized, load once the
+// application starts. The telemetry keys are matched to the processors by
+// name; keys left over (new processors, or records of removed ones) go to the
+// processors without a record.
+static int telemetry_ring_load(void) {
+    bool key_taken[CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_RECORD_RING_MAX_KEYS] = {false};
+
+    for (size_t i = 0; i < runtime_processors_count; i++) {
+        struct runtime_processor_data *data = runtime_processors[i]->data;
+        data->telemetry_ring_key = UINT8_MAX;
+    }
+
+    for (size_t n = 0; n < runtime_processors_count; n++) {
+        uint8_t key = ZMK_INPUT_PROCESSOR_RECORD_KEY_TELEMETRY(n);
+        struct telemetry_ring_record record;
+        int ret = zmk_input_processor_record_ring_read(key, &record, sizeof(record));
+        if (ret != sizeof(record)) {
+            if (ret < 0 && ret != -ENOENT) {
+                LOG_WRN("Failed to load telemetry record %d: %d", key, ret);
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < runtime_processors_count; i++) {
+            const struct runtime_processor_config *cfg = runtime_processors[i]->config;
+            struct runtime_processor_data *data = runtime_processors[i]->data;
+            if (data->telemetry_ring_key == UINT8_MAX &&
+                telemetry_name_crc(cfg) == record.name_crc) {
+                data->telemetry_ring_key = key;
+                data->telemetry = record.telemetry;
+                data->telemetry_from_ring = true;
+                key_taken[n] = true;
+                break;
+            }
+        }
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < runtime_processors_count; i++) {
+        struct runtime_processor_data *data = runtime_processors[i]->data;
+        if (data->telemetry_ring_key != UINT8_MAX) {
+            continue;
+        }
+        while (key_taken[n]) {
+            n++;
+        }
+        data->telemetry_ring_key = ZMK_INPUT_PROCESSOR_RECORD_KEY_TELEMETRY(n);
+        key_taken[n] = true;
+    }
+    return 0;
+}
+
+SYS_INIT(telemetry_ring_load, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
 #endif
 
 // Event listener for keycode changes (for timestamp tracking)
@@ -1029,18 +2363,13 @@ static int keycode_state_changed_listener(const zmk_event_t *eh) {
     return ZMK_EV_EVENT_BUBBLE;
 }
 
-// Event listener for position changes (for temp-layer deactivation logic)
-static int position_state_changed_listener(const zmk_event_t *eh) {
-    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
-    if (ev == NULL) {
-        return ZMK_EV_EVENT_BUBBLE;
-    }
-
-    // Only handle key presses
-    if (!ev->state) {
-        return ZMK_EV_EVENT_BUBBLE;
-    }
-
+// Decide whether a key press deactivates the temp-layer layer of each
+// processor. The binding is resolved against the layer state captured when
+// the key was pressed. The keymap has already resolved the press by then, but
+// the layer is only deactivated when its binding at the position is
+// transparent, so the press fell through to the same binding it would have
+// found without the layer.
+static void evaluate_temp_layer_keypress(uint32_t position, zmk_keymap_layers_state_t layer_state) {
     // Check temp-layer deactivation for all processors
     for (size_t i = 0; i < runtime_processors_count; i++) {
         const struct device *dev = runtime_processors[i];
@@ -1057,7 +2386,7 @@ static int position_state_changed_listener(const zmk_event_t *eh) {
         // position
         zmk_keymap_layer_id_t temp_layer_layer_id = data->temp_layer_layer;
         const struct zmk_behavior_binding *temp_layer_binding =
-            zmk_keymap_get_layer_binding_at_idx(temp_layer_layer_id, ev->position);
+            zmk_keymap_get_layer_binding_at_idx(temp_layer_layer_id, position);
 
         // If temp-layer layer has non-transparent binding, don't deactivate
         // Use device pointer comparison if transparent behavior is configured
@@ -1077,7 +2406,7 @@ static int position_state_changed_listener(const zmk_event_t *eh) {
             if (!is_transparent) {
                 LOG_DBG("Temp-layer layer has non-transparent binding at position "
                         "%d, not deactivating",
-                        ev->position);
+                        position);
                 continue;
             }
         }
@@ -1093,12 +2422,12 @@ static int position_state_changed_listener(const zmk_event_t *eh) {
                 continue;
             }
 
-            if (!zmk_keymap_layer_active(layer_id)) {
+            if (!(layer_state & BIT(layer_id))) {
                 continue;
             }
 
             const struct zmk_behavior_binding *binding =
-                zmk_keymap_get_layer_binding_at_idx(layer_id, ev->position);
+                zmk_keymap_get_layer_binding_at_idx(layer_id, position);
 
             if (binding) {
                 bool binding_is_transparent = false;
@@ -1164,7 +2493,7 @@ static int position_state_changed_listener(const zmk_event_t *eh) {
 
         // Deactivate the temp-layer layer
         LOG_DBG("Deactivating temp-layer layer %d due to key press at position %d",
-                data->temp_layer_layer, ev->position);
+                data->temp_layer_layer, position);
         k_work_cancel_delayable(&data->temp_layer_deactivation_work);
         int ret = zmk_keymap_layer_deactivate(data->temp_layer_layer);
         if (ret == 0) {
@@ -1172,6 +2501,99 @@ static int position_state_changed_listener(const zmk_event_t *eh) {
             LOG_INF("Temp-layer layer %d deactivated by key press", data->temp_layer_layer);
         }
     }
+}
+
+// Key presses waiting for temp-layer evaluation. The position listener only
+// queues them, so resolving bindings stays off ZMK's key event dispatch.
+#define KEYPRESS_QUEUE_SIZE 8
+
+struct pending_keypress {
+    uint32_t position;
+    zmk_keymap_layers_state_t layer_state;
+};
+
+static struct pending_keypress keypress_queue[KEYPRESS_QUEUE_SIZE];
+static uint8_t keypress_queue_head;
+static uint8_t keypress_queue_len;
+static struct k_spinlock keypress_queue_lock;
+// Serializes draining, so a motion event never overtakes a press being evaluated
+static K_MUTEX_DEFINE(keypress_drain_mutex);
+// Presses queued but not yet evaluated. Unlike keypress_queue_len this stays
+// set while a popped press is being evaluated, so the event path knows to wait.
+static atomic_t keypress_unevaluated;
+static uint32_t keypress_dropped;
+
+static bool keypress_queue_pop(struct pending_keypress *out) {
+    bool popped = false;
+    k_spinlock_key_t key = k_spin_lock(&keypress_queue_lock);
+    if (keypress_queue_len > 0) {
+        *out = keypress_queue[keypress_queue_head];
+        keypress_queue_head = (keypress_queue_head + 1) % KEYPRESS_QUEUE_SIZE;
+        keypress_queue_len--;
+        popped = true;
+    }
+    k_spin_unlock(&keypress_queue_lock, key);
+    return popped;
+}
+
+static void drain_pending_keypresses(void) {
+    if (atomic_get(&keypress_unevaluated) == 0) {
+        return;
+    }
+
+    k_mutex_lock(&keypress_drain_mutex, K_FOREVER);
+    struct pending_keypress press;
+    while (keypress_queue_pop(&press)) {
+        evaluate_temp_layer_keypress(press.position, press.layer_state);
+        atomic_dec(&keypress_unevaluated);
+    }
+    k_mutex_unlock(&keypress_drain_mutex);
+}
+
+static void keypress_work_handler(struct k_work *work) {
+    zmk_input_processor_runtime_stack_mark(ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_WORK);
+    drain_pending_keypresses();
+}
+
+static K_WORK_DEFINE(keypress_work, keypress_work_handler);
+
+// Event listener for position changes (for temp-layer deactivation logic)
+static int position_state_changed_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    if (ev == NULL) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    // Only handle key presses
+    if (!ev->state) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    struct pending_keypress dropped = {0};
+    bool full = false;
+    k_spinlock_key_t key = k_spin_lock(&keypress_queue_lock);
+    if (keypress_queue_len == KEYPRESS_QUEUE_SIZE) {
+        // Drop the oldest press, the newest ones matter most
+        dropped = keypress_queue[keypress_queue_head];
+        full = true;
+        keypress_queue_head = (keypress_queue_head + 1) % KEYPRESS_QUEUE_SIZE;
+        keypress_queue_len--;
+        keypress_dropped++;
+    } else {
+        atomic_inc(&keypress_unevaluated);
+    }
+    struct pending_keypress *slot =
+        &keypress_queue[(keypress_queue_head + keypress_queue_len) % KEYPRESS_QUEUE_SIZE];
+    slot->position = ev->position;
+    slot->layer_state = zmk_keymap_layer_state();
+    keypress_queue_len++;
+    k_spin_unlock(&keypress_queue_lock, key);
+
+    if (full) {
+        LOG_WRN("Key press queue full, dropped press at position %d", dropped.position);
+    }
+
+    k_work_submit(&keypress_work);
 
     return ZMK_EV_EVENT_BUBBLE;
 }
@@ -1182,6 +2604,108 @@ ZMK_SUBSCRIPTION(runtime_processor_keycode_listener, zmk_keycode_state_changed);
 ZMK_LISTENER(runtime_processor_position_listener, position_state_changed_listener);
 ZMK_SUBSCRIPTION(runtime_processor_position_listener, zmk_position_state_changed);
 
+static void capture_processor_diagnostics(const struct device *dev, int64_t now,
+                                          struct zmk_input_processor_runtime_diagnostics *rec) {
+    struct runtime_processor_data *data = dev->data;
+    uint16_t flags = 0;
+    uint16_t work = 0;
+
+    memset(rec, 0, sizeof(*rec));
+    rec->id = zmk_input_processor_runtime_get_id(dev);
+    rec->temp_layer_layer = data->temp_layer_layer;
+    rec->axis_snap_mode = data->axis_snap_mode;
+    k_spinlock_key_t key = k_spin_lock(&keypress_queue_lock);
+    rec->pending_keypresses = keypress_queue_len;
+    rec->dropped_keypresses = keypress_dropped;
+    k_spin_unlock(&keypress_queue_lock, key);
+    rec->scale_multiplier = data->scale_multiplier;
+    rec->scale_divisor = data->scale_divisor;
+    rec->rotation_degrees = data->rotation_degrees;
+    rec->active_layers = data->active_layers;
+    rec->last_x = data->last_x;
+    rec->last_y = data->last_y;
+    rec->axis_snap_cross_axis_accum = data->axis_snap_cross_axis_accum;
+    rec->uptime_ms = (uint32_t)now;
+    rec->last_input_ms = (uint32_t)data->last_input_timestamp;
+    rec->last_keypress_ms = (uint32_t)data->last_keypress_timestamp;
+    rec->axis_snap_last_decay_ms = (uint32_t)data->axis_snap_last_decay_timestamp;
+
+    flags |= data->has_x ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_HAS_X : 0;
+    flags |= data->has_y ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_HAS_Y : 0;
+    flags |= data->remainder_reset_x ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_REMAINDER_RESET_X : 0;
+    flags |= data->remainder_reset_y ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_REMAINDER_RESET_Y : 0;
+    flags |= data->temp_layer_enabled ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_TEMP_LAYER_ENABLED : 0;
+    flags |= data->temp_layer_layer_active ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_TEMP_LAYER_ACTIVE : 0;
+    flags |= data->temp_layer_keep_active ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_TEMP_LAYER_KEEP_ACTIVE
+                                          : 0;
+    flags |= data->xy_to_scroll_enabled ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_XY_TO_SCROLL : 0;
+    flags |= data->xy_swap_enabled ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_XY_SWAP : 0;
+    flags |= data->x_invert ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_X_INVERT : 0;
+    flags |= data->y_invert ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_Y_INVERT : 0;
+
+    if (k_work_delayable_is_pending(&data->temp_layer_activation_work)) {
+        work |= ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_TEMP_LAYER_ACTIVATION;
+    }
+    if (k_work_delayable_is_pending(&data->temp_layer_deactivation_work)) {
+        work |= ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_TEMP_LAYER_DEACTIVATION;
+    }
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (k_work_delayable_is_pending(&data->save_work)) {
+        work |= ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_SAVE;
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_HISTORY)
+    rec->history_count = motion_history_count(&data->history);
+#endif
+
+#if TELEMETRY_SAVE
+    if (k_work_delayable_is_pending(&data->telemetry_save_work)) {
+        work |= ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_TELEMETRY_SAVE;
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SENSOR_OFFLOAD)
+    flags |= data->sensor_offload_active ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_SENSOR_OFFLOAD : 0;
+    if (k_work_is_pending(&data->sensor_offload_work)) {
+        work |= ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_SENSOR_OFFLOAD;
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GESTURE)
+    flags |= data->gesture_tracking ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_GESTURE_TRACKING : 0;
+    if (k_work_delayable_is_pending(&data->gesture_work)) {
+        work |= ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_WORK_GESTURE;
+    }
+#endif
+
+    flags |= governor_degraded(data) ? ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_GOVERNOR_DEGRADED : 0;
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_GYRO)
+    rec->gyro_bias_q8[0] = data->gyro_bias_q8[0];
+    rec->gyro_bias_q8[1] = data->gyro_bias_q8[1];
+#endif
+
+    rec->flags = flags;
+    rec->pending_work = work;
+}
+
+size_t zmk_input_processor_runtime_capture_diagnostics(
+    struct zmk_input_processor_runtime_diagnostics *records, size_t max_records) {
+    size_t count = MIN(max_records, runtime_processors_count);
+
+    // Event handling and work items run in threads, so with the scheduler
+    // locked no processor changes while the snapshot is taken
+    k_sched_lock();
+    int64_t now = k_uptime_get();
+    for (size_t i = 0; i < count; i++) {
+        capture_processor_diagnostics(runtime_processors[i], now, &records[i]);
+    }
+    k_sched_unlock();
+
+    return count;
+}
+
 // Temp-layer layer configuration API
 int zmk_input_processor_runtime_set_temp_layer(const struct device *dev, bool enabled,
                                                uint8_t layer, uint32_t activation_delay_ms,
@@ -1377,6 +2901,8 @@ int zmk_input_processor_runtime_set_axis_snap_mode(const struct device *dev, uin
 
     LOG_INF("Axis snap mode: %d%s", mode, persistent ? " (persistent)" : " (temporary)");
 
+    schedule_sensor_offload(dev);
+
     int ret = 0;
 #if IS_ENABLED(CONFIG_SETTINGS)
     if (persistent) {
@@ -1469,6 +2995,8 @@ int zmk_input_processor_runtime_set_axis_snap(const struct device *dev, uint8_t
     LOG_INF("Axis snap config: mode=%d, threshold=%d, timeout=%d ms%s", mode, threshold, timeout_ms,
             persistent ? " (persistent)" : " (temporary)");
 
+    schedule_sensor_offload(dev);
+
     int ret = 0;
 #if IS_ENABLED(CONFIG_SETTINGS)
     if (persistent) {
@@ -1492,6 +3020,7 @@ int zmk_input_processor_runtime_set_x_invert(const struct device *dev, bool inve
     if (persistent) {
         data->persistent_x_invert = invert;
     }
+    schedule_sensor_offload(dev);
 
     LOG_INF("X axis invert: %s%s", invert ? "true" : "false",
             persistent ? " (persistent)" : " (temporary)");
@@ -1519,6 +3048,7 @@ int zmk_input_processor_runtime_set_y_invert(const struct device *dev, bool inve
     if (persistent) {
         data->persistent_y_invert = invert;
     }
+    schedule_sensor_offload(dev);
 
     LOG_INF("Y axis invert: %s%s", invert ? "true" : "false",
             persistent ? " (persistent)" : " (temporary)");
@@ -1564,6 +3094,7 @@ int zmk_input_processor_runtime_set_xy_to_scroll_enabled(const struct device *de
     if (persistent) {
         data->persistent_xy_to_scroll_enabled = enabled;
     }
+    schedule_sensor_offload(dev);
 
     LOG_INF("XY-to-scroll enabled: %d%s", enabled, persistent ? " (persistent)" : " (temporary)");
 
@@ -1590,6 +3121,7 @@ int zmk_input_processor_runtime_set_xy_swap_enabled(const struct device *dev, bo
     if (persistent) {
         data->persistent_xy_swap_enabled = enabled;
     }
+    schedule_sensor_offload(dev);
 
     LOG_INF("XY-swap enabled: %d%s", enabled, persistent ? " (persistent)" : " (temporary)");
 
@@ -1603,3 +3135,109 @@ int zmk_input_processor_runtime_set_xy_swap_enabled(const struct device *dev, bo
 
     return ret;
 }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STACK_REPORT)
+// Distinct threads remembered per code path (e.g. input from several drivers)
+#define STACK_REPORT_THREADS 3
+
+// Marked from every thread on the paths, read by the report
+static k_tid_t stack_report_threads[ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_COUNT]
+                                   [STACK_REPORT_THREADS];
+static struct k_spinlock stack_report_lock;
+
+static const char *const stack_path_names[] = {
+    [ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_INPUT] = "input",
+    [ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_RPC] = "rpc",
+    [ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_NOTIFY] = "notify",
+    [ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_WORK] = "work",
+};
+
+void zmk_input_processor_runtime_stack_mark(enum zmk_input_processor_runtime_stack_path path) {
+    if (path >= ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_COUNT || k_is_in_isr()) {
+        return;
+    }
+
+    k_tid_t current = k_current_get();
+    k_tid_t *threads = stack_report_threads[path];
+    k_spinlock_key_t key = k_spin_lock(&stack_report_lock);
+    for (int i = 0; i < STACK_REPORT_THREADS; i++) {
+        if (threads[i] == current) {
+            break;
+        }
+        if (threads[i] == NULL) {
+            threads[i] = current;
+            break;
+        }
+    }
+    k_spin_unlock(&stack_report_lock, key);
+}
+
+int zmk_input_processor_runtime_foreach_stack_usage(
+    int (*callback)(const struct zmk_input_processor_runtime_stack_usage *usage, void *user_data),
+    void *user_data) {
+    for (int path = 0; path < ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_COUNT; path++) {
+        for (int i = 0; i < STACK_REPORT_THREADS; i++) {
+            k_spinlock_key_t key = k_spin_lock(&stack_report_lock);
+            k_tid_t thread = stack_report_threads[path][i];
+            k_spin_unlock(&stack_report_lock, key);
+            if (thread == NULL) {
+                break;
+            }
+
+            // Counts the untouched part of the stack, painted by CONFIG_INIT_STACKS
+            size_t unused;
+            int err = k_thread_stack_space_get(thread, &unused);
+            if (err < 0) {
+                LOG_WRN("Failed to measure stack of %p: %d", thread, err);
+                continue;
+            }
+
+            const char *name = k_thread_name_get(thread);
+            struct zmk_input_processor_runtime_stack_usage usage = {
+                .path = path,
+                .thread_name = name ? name : "?",
+                .size = thread->stack_info.size,
+                .used = thread->stack_info.size - unused,
+            };
+            int ret = callback(&usage, user_data);
+            if (ret != 0) {
+                return ret;
+            }
+        }
+    }
+    return 0;
+}
+
+static int log_stack_usage(const struct zmk_input_processor_runtime_stack_usage *usage,
+                           void *user_data) {
+    LOG_INF("Stack report: %s on %s: %d of %d bytes used, %d free", stack_path_names[usage->path],
+            usage->thread_name, (int)usage->used, (int)usage->size,
+            (int)(usage->size - usage->used));
+    return 0;
+}
+
+static void stack_report_work_handler(struct k_work *work) {
+    zmk_input_processor_runtime_foreach_stack_usage(log_stack_usage, NULL);
+}
+
+static K_WORK_DELAYABLE_DEFINE(stack_report_work, stack_report_work_handler);
+
+static int stack_report_init(void) {
+    if (CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STACK_REPORT_DELAY_MS > 0) {
+        k_work_schedule(&stack_report_work,
+                        K_MSEC(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STACK_REPORT_DELAY_MS));
+    }
+    return 0;
+}
+
+SYS_INIT(stack_report_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#else
+
+int zmk_input_processor_runtime_foreach_stack_usage(
+    int (*callback)(const struct zmk_input_processor_runtime_stack_usage *usage, void *user_data),
+    void *user_data) {
+    return -ENOTSUP;
+}
+
+#endif
@@ -74,6 +74,14 @@ static int handle_set_x_invert(const cormoran_rip_SetXInvertRequest *req,
                                cormoran_rip_Response *resp);
 static int handle_set_y_invert(const cormoran_rip_SetYInvertRequest *req,
                                cormoran_rip_Response *resp);
+static int handle_get_telemetry(const cormoran_rip_GetTelemetryRequest *req,
+                                cormoran_rip_Response *resp);
+static int handle_reset_telemetry(const cormoran_rip_ResetTelemetryRequest *req,
+                                  cormoran_rip_Response *resp);
+static int handle_get_diagnostics(const cormoran_rip_GetDiagnosticsRequest *req,
+                                  cormoran_rip_Response *resp);
+static int handle_get_stack_usage(const cormoran_rip_GetStackUsageRequest *req,
+                                  cormoran_rip_Response *resp);
 
 /**
  * Main request handler for the custom RPC subsystem.
@@ -83,6 +91,8 @@ static bool rip_rpc_handle_request(const zmk_custom_CallRequest *raw_request,
     cormoran_rip_Response *resp =
         ZMK_RPC_CUSTOM_SUBSYSTEM_RESPONSE_BUFFER_ALLOCATE(cormoran_rip, encode_response);
 
+    zmk_input_processor_runtime_stack_mark(ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_RPC);
+
     cormoran_rip_Request req = cormoran_rip_Request_init_zero;
 
     // Decode the incoming request from the raw payload
@@ -151,12 +161,25 @@ static bool rip_rpc_handle_request(const zmk_custom_CallRequest *raw_request,
         break;
     case cormoran_rip_Request_set_xy_swap_enabled_tag:
         rc = handle_set_xy_swap_enabled(&req.request_type.set_xy_swap_enabled, resp);
+        break;
     case cormoran_rip_Request_set_x_invert_tag:
         rc = handle_set_x_invert(&req.request_type.set_x_invert, resp);
         break;
     case cormoran_rip_Request_set_y_invert_tag:
         rc = handle_set_y_invert(&req.request_type.set_y_invert, resp);
         break;
+    case cormoran_rip_Request_get_telemetry_tag:
+        rc = handle_get_telemetry(&req.request_type.get_telemetry, resp);
+        break;
+    case cormoran_rip_Request_reset_telemetry_tag:
+        rc = handle_reset_telemetry(&req.request_type.reset_telemetry, resp);
+        break;
+    case cormoran_rip_Request_get_diagnostics_tag:
+        rc = handle_get_diagnostics(&req.request_type.get_diagnostics, resp);
+        break;
+    case cormoran_rip_Request_get_stack_usage_tag:
+        rc = handle_get_stack_usage(&req.request_type.get_stack_usage, resp);
+        break;
     default:
         LOG_WRN("Unsupported rip request type: %d", req.which_request_type);
         rc = -1;
@@ -248,19 +271,8 @@ static int handle_get_input_processor(const cormoran_rip_GetInputProcessorReques
     result.processor.id = req->id;
     strncpy(result.processor.name, name, sizeof(result.processor.name) - 1);
     result.processor.name[sizeof(result.processor.name) - 1] = '\0';
-    result.processor.scale_multiplier = config.scale_multiplier;
-    result.processor.scale_divisor = config.scale_divisor;
-    result.processor.rotation_degrees = config.rotation_degrees;
-    result.processor.temp_layer_enabled = config.temp_layer_enabled;
-    result.processor.temp_layer_layer = config.temp_layer_layer;
-    result.processor.temp_layer_activation_delay_ms = config.temp_layer_activation_delay_ms;
-    result.processor.temp_layer_deactivation_delay_ms = config.temp_layer_deactivation_delay_ms;
-    result.processor.active_layers = config.active_layers;
-    result.processor.axis_snap_mode = (cormoran_rip_AxisSnapMode)config.axis_snap_mode;
-    result.processor.axis_snap_threshold = config.axis_snap_threshold;
-    result.processor.axis_snap_timeout_ms = config.axis_snap_timeout_ms;
-    result.processor.x_invert = config.x_invert;
-    result.processor.y_invert = config.y_invert;
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(ZMK_INPUT_PROCESSOR_RUNTIME_FIELD_COPY, &result.processor,
+                                       &config)
 
     resp->which_response_type = cormoran_rip_Response_get_input_processor_tag;
     resp->response_type.get_input_processor = result;
@@ -681,6 +693,165 @@ static int handle_set_y_invert(const cormoran_rip_SetYInvertRequest *req,
     return 0;
 }
 
+/**
+ * Handle getting sensor health telemetry
+ */
+static int handle_get_telemetry(const cormoran_rip_GetTelemetryRequest *req,
+                                cormoran_rip_Response *resp) {
+    LOG_DBG("Getting telemetry: id=%d", req->id);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    struct zmk_input_processor_runtime_telemetry telemetry;
+    int ret = zmk_input_processor_runtime_get_telemetry(dev, &telemetry);
+    if (ret < 0) {
+        LOG_ERR("Failed to get telemetry: %d", ret);
+        return ret;
+    }
+
+    cormoran_rip_GetTelemetryResponse result = cormoran_rip_GetTelemetryResponse_init_zero;
+    result.has_telemetry = true;
+    result.telemetry.frames = telemetry.frames;
+    result.telemetry.distance = telemetry.distance;
+    result.telemetry.spikes = telemetry.spikes;
+    result.telemetry.jitter_frames = telemetry.jitter_frames;
+    result.telemetry.jitter_max_amplitude = telemetry.jitter_max_amplitude;
+    result.telemetry.zero_runs = telemetry.zero_runs;
+    result.telemetry.max_zero_run = telemetry.max_zero_run;
+
+    resp->which_response_type = cormoran_rip_Response_get_telemetry_tag;
+    resp->response_type.get_telemetry = result;
+
+    return 0;
+}
+
+/**
+ * Handle resetting sensor health telemetry
+ */
+static int handle_reset_telemetry(const cormoran_rip_ResetTelemetryRequest *req,
+                                  cormoran_rip_Response *resp) {
+    LOG_DBG("Resetting telemetry: id=%d", req->id);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    int ret = zmk_input_processor_runtime_reset_telemetry(dev);
+    if (ret < 0) {
+        LOG_ERR("Failed to reset telemetry: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_reset_telemetry_tag;
+    resp->response_type.reset_telemetry =
+        (cormoran_rip_ResetTelemetryResponse)cormoran_rip_ResetTelemetryResponse_init_zero;
+
+    return 0;
+}
+
+// Snapshot taken by the handler and encoded later, when the response is written
+#define DIAGNOSTICS_MAX_RECORDS MAX(DT_NUM_INST_STATUS_OKAY(zmk_input_processor_runtime), 1)
+
+static struct zmk_input_processor_runtime_diagnostics diagnostics_records[DIAGNOSTICS_MAX_RECORDS];
+static size_t diagnostics_count;
+
+static bool encode_diagnostics_records(pb_ostream_t *stream, const pb_field_t *field,
+                                       void *const *arg) {
+    if (!pb_encode_tag_for_field(stream, field)) {
+        return false;
+    }
+    return pb_encode_string(stream, (const pb_byte_t *)diagnostics_records,
+                            diagnostics_count * sizeof(diagnostics_records[0]));
+}
+
+/**
+ * Handle getting a diagnostic snapshot of all input processors
+ */
+static int handle_get_diagnostics(const cormoran_rip_GetDiagnosticsRequest *req,
+                                  cormoran_rip_Response *resp) {
+    LOG_DBG("Getting diagnostics");
+
+    diagnostics_count = zmk_input_processor_runtime_capture_diagnostics(diagnostics_records,
+                                                                        DIAGNOSTICS_MAX_RECORDS);
+
+    cormoran_rip_GetDiagnosticsResponse result = cormoran_rip_GetDiagnosticsResponse_init_zero;
+    result.version = ZMK_INPUT_PROCESSOR_RUNTIME_DIAG_VERSION;
+    result.record_size = sizeof(diagnostics_records[0]);
+    result.records.funcs.encode = encode_diagnostics_records;
+
+    resp->which_response_type = cormoran_rip_Response_get_diagnostics_tag;
+    resp->response_type.get_diagnostics = result;
+
+    return 0;
+}
+
+static bool encode_thread_name(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const char *name = (const char *)*arg;
+    if (!pb_encode_tag_for_field(stream, field)) {
+        return false;
+    }
+    return pb_encode_string(stream, (const pb_byte_t *)name, strlen(name));
+}
+
+struct encode_stack_usage_context {
+    pb_ostream_t *stream;
+    const pb_field_t *field;
+};
+
+static int encode_stack_usage_entry(const struct zmk_input_processor_runtime_stack_usage *usage,
+                                    void *user_data) {
+    struct encode_stack_usage_context *ctx = user_data;
+
+    cormoran_rip_StackUsage entry = cormoran_rip_StackUsage_init_zero;
+    entry.path = (cormoran_rip_StackPath)usage->path;
+    entry.thread.funcs.encode = encode_thread_name;
+    entry.thread.arg = (void *)usage->thread_name;
+    entry.size = usage->size;
+    entry.used = usage->used;
+
+    if (!pb_encode_tag_for_field(ctx->stream, ctx->field)) {
+        return -EIO;
+    }
+    if (!pb_encode_submessage(ctx->stream, cormoran_rip_StackUsage_fields, &entry)) {
+        return -EIO;
+    }
+    return 0;
+}
+
+// Stacks are measured while encoding, so the report reflects this very request
+static bool encode_stack_usage(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    struct encode_stack_usage_context ctx = {.stream = stream, .field = field};
+    return zmk_input_processor_runtime_foreach_stack_usage(encode_stack_usage_entry, &ctx) == 0;
+}
+
+/**
+ * Handle getting the stack high-water marks
+ */
+static int handle_get_stack_usage(const cormoran_rip_GetStackUsageRequest *req,
+                                  cormoran_rip_Response *resp) {
+    LOG_DBG("Getting stack usage");
+
+    if (!IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STACK_REPORT)) {
+        LOG_WRN("Stack report is disabled");
+        return -ENOTSUP;
+    }
+
+    cormoran_rip_GetStackUsageResponse result = cormoran_rip_GetStackUsageResponse_init_zero;
+    result.entries.funcs.encode = encode_stack_usage;
+
+    resp->which_response_type = cormoran_rip_Response_get_stack_usage_tag;
+    resp->response_type.get_stack_usage = result;
+
+    return 0;
+}
+
 /**
  * Handle getting layer information
  */
@@ -10,6 +10,7 @@
 #include <zephyr/logging/log.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/input_processor_state_changed.h>
+#include <zmk/pointing/input_processor_runtime.h>
 #include <zmk/studio/custom.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
@@ -57,6 +58,8 @@ static int input_processor_state_changed_listener(const zmk_event_t *eh) {
         return ZMK_EV_EVENT_BUBBLE;
     }
 
+    zmk_input_processor_runtime_stack_mark(ZMK_INPUT_PROCESSOR_RUNTIME_STACK_PATH_NOTIFY);
+
     LOG_DBG("Input processor state changed: %s (id=%d)", ev->name, ev->id);
 
     cormoran_rip_Notification notification = cormoran_rip_Notification_init_zero;
@@ -68,21 +71,7 @@ static int input_processor_state_changed_listener(const zmk_event_t *eh) {
     info->id = ev->id;
     strncpy(info->name, ev->name, sizeof(info->name) - 1);
     info->name[sizeof(info->name) - 1] = '\0';
-    info->scale_multiplier = ev->config.scale_multiplier;
-    info->scale_divisor = ev->config.scale_divisor;
-    info->rotation_degrees = ev->config.rotation_degrees;
-    info->temp_layer_enabled = ev->config.temp_layer_enabled;
-    info->temp_layer_layer = ev->config.temp_layer_layer;
-    info->temp_layer_activation_delay_ms = ev->config.temp_layer_activation_delay_ms;
-    info->temp_layer_deactivation_delay_ms = ev->config.temp_layer_deactivation_delay_ms;
-    info->active_layers = ev->config.active_layers;
-    info->axis_snap_mode = ev->config.axis_snap_mode;
-    info->axis_snap_threshold = ev->config.axis_snap_threshold;
-    info->axis_snap_timeout_ms = ev->config.axis_snap_timeout_ms;
-    info->xy_to_scroll_enabled = ev->config.xy_to_scroll_enabled;
-    info->xy_swap_enabled = ev->config.xy_swap_enabled;
-    info->x_invert = ev->config.x_invert;
-    info->y_invert = ev->config.y_invert;
+    ZMK_INPUT_PROCESSOR_RUNTIME_FIELDS(ZMK_INPUT_PROCESSOR_RUNTIME_FIELD_COPY, info, &ev->config)
 
     // Send notification via custom studio subsystem
     pb_callback_t encode_cb = {.funcs.encode = encode_notification, .arg = &notification};
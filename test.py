@@ -42,6 +42,18 @@ class WestCommandsTests(unittest.TestCase):
         self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
         self.assertIn("PASS: studio", result.stdout,  result.stdout + result.stderr)
 
+        # Report the flash/RAM cost of each processor from the benchmark build
+        elf = next(tests_build.glob("**/bench-chains/zephyr/zmk.elf"), None)
+        self.assertIsNotNone(elf, f"bench-chains zmk.elf is missing in {tests_build}")
+        footprint = subprocess.run(
+            ["python3", str(THIS_DIR / "tests" / "bench-chains" / "footprint.py"), str(elf)],
+            capture_output=True,
+            text=True,
+        )
+        self.assertEqual(footprint.returncode, 0, footprint.stdout + footprint.stderr)
+        self.assertIn("input_processor_runtime.c", footprint.stdout, footprint.stdout)
+        print(footprint.stdout)
+
     def test_zmk_build(self):
         artifacts_and_expected_config: dict[str, list[str | NotFound]] = {
             "my_awesome_keyboard_with_custom_rpc_support": [
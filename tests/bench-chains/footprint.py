@@ -0,0 +1,70 @@
+"""Flash/RAM cost of the runtime and upstream input processors in a build.
+
+Usage: python tests/bench-chains/footprint.py <zephyr.elf> [--nm <nm>]
+
+Symbols are attributed to source files from the debug info, so the numbers
+cover exactly what each driver adds, including its devicetree instances.
+Pass the toolchain's nm (e.g. arm-zephyr-eabi-nm) for target builds.
+"""
+
+import argparse
+import subprocess
+from collections import defaultdict
+from pathlib import PurePath
+
+SOURCES = [
+    "input_processor_runtime.c",
+    "input_processor_record_ring.c",
+    "input_processor_bench_probe.c",
+    "input_processor_scaler.c",
+    "input_processor_transform.c",
+    "input_processor_temp_layer.c",
+]
+
+# nm symbol types: code and read-only data live in flash, initialized data in
+# both flash and RAM, zero-initialized data in RAM only
+FLASH_TYPES = set("tTrR")
+DATA_TYPES = set("dD")
+BSS_TYPES = set("bB")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="nm")
+    args = parser.parse_args()
+
+    output = subprocess.run(
+        [args.nm, "--print-size", "--line-numbers", "--defined-only", args.elf],
+        capture_output=True,
+        text=True,
+        check=True,
+    ).stdout
+
+    sizes: dict[str, dict[str, int]] = defaultdict(lambda: defaultdict(int))
+    for line in output.splitlines():
+        symbol, _, location = line.partition("\t")
+        fields = symbol.split()
+        if len(fields) < 4 or not location:
+            continue
+        source = PurePath(location.rsplit(":", 1)[0]).name
+        if source not in SOURCES:
+            continue
+        size = int(fields[1], 16)
+        kind = fields[2]
+        if kind in FLASH_TYPES:
+            sizes[source]["flash"] += size
+        elif kind in DATA_TYPES:
+            sizes[source]["flash"] += size
+            sizes[source]["ram"] += size
+        elif kind in BSS_TYPES:
+            sizes[source]["ram"] += size
+
+    print(f"{'source':<34}{'flash':>8}{'ram':>8}")
+    for source in SOURCES:
+        if source in sizes:
+            print(f"{source:<34}{sizes[source]['flash']:>8}{sizes[source]['ram']:>8}")
+
+
+if __name__ == "__main__":
+    main()
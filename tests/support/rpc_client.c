@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * Test-only Studio RPC transport. Shortly after boot it frames a few
+ * cormoran_rip requests into the RPC receive buffer, so the regular RPC thread
+ * decodes and handles them as it would for a Studio client. Responses and
+ * notifications are discarded.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <pb_encode.h>
+#include <zmk/studio/rpc.h>
+#include <zmk/studio/custom.h>
+#include <cormoran/rip/custom.pb.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Studio RPC stream framing
+#define RPC_CLIENT_SOF 0xAB
+#define RPC_CLIENT_ESC 0xAC
+#define RPC_CLIENT_EOF 0xAD
+
+// cormoran_rip is the only custom subsystem in the tests
+#define RPC_CLIENT_SUBSYSTEM_INDEX 0
+
+static const pb_size_t rpc_client_requests[] = {
+    cormoran_rip_Request_list_input_processors_tag,
+    cormoran_rip_Request_get_diagnostics_tag,
+};
+
+static int rpc_client_rx_start(void) { return 0; }
+
+static int rpc_client_rx_stop(void) { return 0; }
+
+static void rpc_client_tx_notify(struct ring_buf *buf, size_t added, bool message_completed,
+                                 void *user_data) {
+    ring_buf_get(buf, NULL, added);
+}
+
+ZMK_RPC_TRANSPORT(rip_test_client, ZMK_TRANSPORT_USB, rpc_client_rx_start, rpc_client_rx_stop,
+                  rpc_client_tx_notify);
+
+static bool rpc_client_put(struct ring_buf *rx, uint8_t byte, bool escape) {
+    uint8_t esc = RPC_CLIENT_ESC;
+
+    if (escape && (byte == RPC_CLIENT_SOF || byte == RPC_CLIENT_ESC || byte == RPC_CLIENT_EOF) &&
+        ring_buf_put(rx, &esc, 1) != 1) {
+        return false;
+    }
+    return ring_buf_put(rx, &byte, 1) == 1;
+}
+
+static int rpc_client_send(uint32_t request_id, pb_size_t tag) {
+    cormoran_rip_Request rip = cormoran_rip_Request_init_zero;
+    rip.which_request_type = tag;
+
+    zmk_studio_Request req = zmk_studio_Request_init_zero;
+    req.request_id = request_id;
+    req.which_subsystem = zmk_studio_Request_custom_tag;
+    req.subsystem.custom.which_request_type = zmk_custom_Request_call_tag;
+    zmk_custom_CallRequest *call = &req.subsystem.custom.request_type.call;
+    call->subsystem_index = RPC_CLIENT_SUBSYSTEM_INDEX;
+
+    pb_ostream_t payload = pb_ostream_from_buffer(call->payload.bytes, sizeof(call->payload.bytes));
+    if (!pb_encode(&payload, cormoran_rip_Request_fields, &rip)) {
+        LOG_ERR("RPC client: failed to encode request %d: %s", tag, PB_GET_ERROR(&payload));
+        return -EINVAL;
+    }
+    call->payload.size = payload.bytes_written;
+
+    uint8_t msg[zmk_studio_Request_size];
+    pb_ostream_t stream = pb_ostream_from_buffer(msg, sizeof(msg));
+    if (!pb_encode(&stream, zmk_studio_Request_fields, &req)) {
+        LOG_ERR("RPC client: failed to encode message %d: %s", tag, PB_GET_ERROR(&stream));
+        return -EINVAL;
+    }
+
+    struct ring_buf *rx = zmk_rpc_get_rx_buf();
+    bool ok = rpc_client_put(rx, RPC_CLIENT_SOF, false);
+    for (size_t i = 0; ok && i < stream.bytes_written; i++) {
+        ok = rpc_client_put(rx, msg[i], true);
+    }
+    ok = ok && rpc_client_put(rx, RPC_CLIENT_EOF, false);
+    zmk_rpc_rx_notify();
+
+    if (!ok) {
+        LOG_ERR("RPC client: receive buffer full, request %d truncated", tag);
+        return -ENOMEM;
+    }
+    return 0;
+}
+
+static void rpc_client_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(rpc_client_work, rpc_client_work_handler);
+static size_t rpc_client_sent;
+
+// One request per run, so the small receive buffer never holds more than one
+static void rpc_client_work_handler(struct k_work *work) {
+    if (rpc_client_sent >= ARRAY_SIZE(rpc_client_requests)) {
+        LOG_DBG("RPC client: requests sent");
+        return;
+    }
+
+    rpc_client_send(rpc_client_sent + 1, rpc_client_requests[rpc_client_sent]);
+    rpc_client_sent++;
+    k_work_schedule(&rpc_client_work, K_MSEC(50));
+}
+
+static int rpc_client_init(void) {
+    k_work_schedule(&rpc_client_work, K_MSEC(100));
+    return 0;
+}
+
+SYS_INIT(rpc_client_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * Test-only log backend that makes logging slow. With immediate logging the
+ * backends run inside the logging call, so busy-waiting on the event path's
+ * debug traces adds a fixed load to the processor's measured handler time.
+ * Only the first messages containing the configured text are slowed down.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_msg.h>
+#include <zephyr/sys/cbprintf.h>
+
+BUILD_ASSERT(IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
+             "The slow log backend needs CONFIG_LOG_MODE_IMMEDIATE");
+
+// Long enough for the function name prefix of debug messages and the match
+#define SLOW_LOG_TEXT_LEN 96
+
+struct slow_log_text {
+    char text[SLOW_LOG_TEXT_LEN];
+    size_t len;
+};
+
+static uint32_t slow_log_count;
+
+static int slow_log_out(int c, void *ctx) {
+    struct slow_log_text *buf = ctx;
+
+    if (buf->len < sizeof(buf->text) - 1) {
+        buf->text[buf->len++] = (char)c;
+    }
+    return c;
+}
+
+static void slow_log_process(const struct log_backend *const backend,
+                             union log_msg_generic *msg) {
+    if (slow_log_count >= CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TEST_SLOW_LOG_MESSAGES) {
+        return;
+    }
+
+    size_t len;
+    uint8_t *package = log_msg_get_package(&msg->log, &len);
+    if (len == 0) {
+        return;
+    }
+
+    struct slow_log_text buf = {0};
+    cbpprintf(slow_log_out, &buf, package);
+    if (strstr(buf.text, CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TEST_SLOW_LOG_MATCH) == NULL) {
+        return;
+    }
+
+    slow_log_count++;
+    k_busy_wait(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TEST_SLOW_LOG_US);
+}
+
+static void slow_log_panic(const struct log_backend *const backend) {}
+
+static const struct log_backend_api slow_log_api = {
+    .process = slow_log_process,
+    .panic = slow_log_panic,
+};
+
+LOG_BACKEND_DEFINE(rip_test_slow_log, slow_log_api, true);